@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ccs::bench {
+
+/// Per-run state handed to a benchmark function.
+/// The timed region is everything between the first and the last keepRunning() call.
+class State {
+public:
+    State(int64_t iterations, int64_t arg) : m_remaining(iterations), m_iterations(iterations), m_arg(arg) {}
+
+    bool keepRunning()
+    {
+        if (!m_started) {
+            m_started = true;
+            m_begin = std::chrono::steady_clock::now();
+        }
+        if (m_remaining-- > 0) return true;
+        m_end = std::chrono::steady_clock::now();
+        return false;
+    }
+
+    int64_t arg() const { return m_arg; }
+    int64_t iterations() const { return m_iterations; }
+    double elapsedNs() const { return std::chrono::duration<double, std::nano>(m_end - m_begin).count(); }
+
+    void setItemsProcessed(int64_t items) { m_items = items; }
+    int64_t itemsProcessed() const { return m_items; }
+    void setLabel(const std::string& label) { m_label = label; }
+    const std::string& label() const { return m_label; }
+
+private:
+    int64_t m_remaining = 0;
+    int64_t m_iterations = 0;
+    int64_t m_arg = 0;
+    int64_t m_items = 0;
+    bool m_started = false;
+    std::chrono::steady_clock::time_point m_begin;
+    std::chrono::steady_clock::time_point m_end;
+    std::string m_label;
+};
+
+using BenchFn = void (*)(State&);
+
+struct Benchmark {
+    std::string name;
+    BenchFn fn = nullptr;
+    std::vector<int64_t> args;
+};
+
+/// Global registry, filled by CCS_BENCHMARK at static-init time
+std::vector<Benchmark>& registry();
+
+struct Registration {
+    Registration(const char* name, BenchFn fn, std::vector<int64_t> args = {})
+    {
+        registry().push_back({name, fn, std::move(args)});
+    }
+};
+
+/// Keep the compiler from discarding a value computed inside the timed loop
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace ccs::bench
+
+#define CCS_BENCH_CONCAT_(a, b) a##b
+#define CCS_BENCH_CONCAT(a, b) CCS_BENCH_CONCAT_(a, b)
+
+/// Register a benchmark, optionally with a list of integer arguments (State::arg())
+#define CCS_BENCHMARK(fn, ...) \
+    static ::ccs::bench::Registration CCS_BENCH_CONCAT(ccs_bench_reg_, __LINE__)(#fn, fn, {__VA_ARGS__})
@@ -0,0 +1,194 @@
+#include "bench.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace ccs::bench {
+
+std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+} // namespace ccs::bench
+
+using namespace ccs::bench;
+
+namespace {
+
+constexpr double MinRunTimeNs = 200e6; // grow iteration count until a run takes >= 200 ms
+
+struct Result {
+    std::string name;
+    int64_t iterations = 0;
+    double nsPerIter = 0.0;
+    double itemsPerSecond = 0.0;
+    std::string label;
+};
+
+Result runOne(const Benchmark& bench, int64_t arg, bool hasArg)
+{
+    Result result;
+    result.name = hasArg ? bench.name + "/" + std::to_string(arg) : bench.name;
+
+    int64_t iterations = 1;
+    for (;;) {
+        State state(iterations, arg);
+        bench.fn(state);
+        double elapsed = state.elapsedNs();
+        if (elapsed >= MinRunTimeNs || iterations >= (int64_t(1) << 40)) {
+            result.iterations = iterations;
+            result.nsPerIter = elapsed / static_cast<double>(iterations);
+            if (state.itemsProcessed() > 0 && elapsed > 0.0) {
+                result.itemsPerSecond = static_cast<double>(state.itemsProcessed()) * 1e9 / elapsed;
+            }
+            result.label = state.label();
+            return result;
+        }
+        // Aim slightly past the target so the next run is usually the last one
+        double scale = (elapsed > 0.0) ? (MinRunTimeNs * 1.4 / elapsed) : 10.0;
+        scale = std::min(std::max(scale, 2.0), 100.0);
+        iterations = static_cast<int64_t>(static_cast<double>(iterations) * scale);
+    }
+}
+
+std::string jsonEscape(const std::string& text)
+{
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+/// Write results in the Google Benchmark JSON layout ("context" + "benchmarks" with
+/// real_time/time_unit/items_per_second), so its compare.py also works on our files.
+/// Only wall-clock time is measured; cpu_time repeats it.
+bool writeJson(const char* path, const char* executable, const std::vector<Result>& results)
+{
+    std::ofstream out(path);
+    if (!out) return false;
+    out.precision(12);
+
+    char date[32] = {};
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"" << jsonEscape(executable) << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i ? ",\n" : "\n")
+            << "    {\n"
+            << "      \"name\": \"" << jsonEscape(r.name) << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << r.iterations << ",\n"
+            << "      \"real_time\": " << r.nsPerIter << ",\n"
+            << "      \"cpu_time\": " << r.nsPerIter << ",\n"
+            << "      \"time_unit\": \"ns\"";
+        if (r.itemsPerSecond > 0.0) out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+        if (!r.label.empty()) out << ",\n      \"label\": \"" << jsonEscape(r.label) << "\"";
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+/// Read name → real_time (ns) from a file written by writeJson()
+std::map<std::string, double> readBaseline(const char* path)
+{
+    std::map<std::string, double> times;
+    std::ifstream in(path);
+    if (!in) return times;
+
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    const std::string nameKey = "\"name\": \"";
+    const std::string timeKey = "\"real_time\": ";
+    for (size_t pos = text.find(nameKey); pos != std::string::npos; pos = text.find(nameKey, pos)) {
+        pos += nameKey.size();
+        std::string name;
+        while (pos < text.size() && text[pos] != '"') {
+            if (text[pos] == '\\' && pos + 1 < text.size()) ++pos;
+            name += text[pos++];
+        }
+        size_t timePos = text.find(timeKey, pos);
+        if (timePos == std::string::npos) break;
+        times[name] = std::strtod(text.c_str() + timePos + timeKey.size(), nullptr);
+    }
+    return times;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const char* filter = nullptr;
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i] + 9;
+        else if (std::strncmp(argv[i], "--json=", 7) == 0) jsonPath = argv[i] + 7;
+        else if (std::strncmp(argv[i], "--baseline=", 11) == 0) baselinePath = argv[i] + 11;
+    }
+
+    std::map<std::string, double> baseline;
+    if (baselinePath) {
+        baseline = readBaseline(baselinePath);
+        if (baseline.empty()) {
+            std::fprintf(stderr, "No baseline results in %s\n", baselinePath);
+            return 1;
+        }
+    }
+
+    std::printf("%-48s %14s %14s %16s", "Benchmark", "Time (ns)", "Iterations", "Items/s");
+    std::printf(baselinePath ? " %10s\n" : "\n", "vs base");
+
+    std::vector<Result> results;
+    for (const auto& bench : registry()) {
+        if (filter && bench.name.find(filter) == std::string::npos) continue;
+
+        std::vector<int64_t> args = bench.args;
+        bool hasArg = !args.empty();
+        if (!hasArg) args.push_back(0);
+
+        for (int64_t arg : args) {
+            Result r = runOne(bench, arg, hasArg);
+            std::printf("%-48s %14.1f %14lld %16.0f", r.name.c_str(), r.nsPerIter,
+                        static_cast<long long>(r.iterations), r.itemsPerSecond);
+            if (baselinePath) {
+                auto it = baseline.find(r.name);
+                if (it != baseline.end() && it->second > 0.0) {
+                    std::printf(" %+9.1f%%", (r.nsPerIter / it->second - 1.0) * 100.0);
+                } else {
+                    std::printf(" %10s", "new");
+                }
+            }
+            std::printf(" %s\n", r.label.c_str());
+            results.push_back(r);
+        }
+    }
+
+    if (jsonPath && !writeJson(jsonPath, argv[0], results)) {
+        std::fprintf(stderr, "Failed to write %s\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}
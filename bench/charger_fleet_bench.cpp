@@ -0,0 +1,147 @@
+#include "bench.h"
+#include "module/charger_fleet.h"
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccs;
+using namespace ccs::bench;
+
+namespace {
+
+/// Open bus that drops what is written; frames are fed through ChargerFleet::postFrame()
+class NullBus : public CanInterface {
+public:
+    bool open(uint16_t, uint32_t) override { return true; }
+    void close() override {}
+    bool isOpen() const override { return true; }
+    bool write(const CanFrame&) override { ++written; return true; }
+    std::vector<ChannelInfo> availableChannels() override { return {}; }
+    CanStatus status() const override { return CanStatus::Ok; }
+    QString lastError() const override { return {}; }
+
+    std::atomic<uint64_t> written{0};
+};
+
+/// Per-module start/stop logging would drown the results
+void quietDebug(QtMsgType type, const QMessageLogContext&, const QString& message)
+{
+    if (type != QtDebugMsg) std::fprintf(stderr, "%s\n", qPrintable(message));
+}
+
+struct Fleet {
+    explicit Fleet(int modules)
+    {
+        static bool quiet = (qInstallMessageHandler(quietDebug), true);
+        (void)quiet;
+        for (int i = 0; i < modules; ++i) {
+            buses.push_back(std::make_unique<NullBus>());
+            fleet.addModule(buses.back().get());
+        }
+        fleet.loadDbc(CCS_BENCH_DBC);
+    }
+
+    std::vector<std::unique_ptr<NullBus>> buses; // outlive the fleet, which sends on stop
+    ChargerFleet fleet;
+};
+
+/// One 100 ms CMS cycle: status, limits, heartbeat and error frames.
+/// cycle varies the alive counter and present current, as on a live bus.
+std::array<CanFrame, 4> cmsCycle(uint32_t cycle)
+{
+    std::array<CanFrame, 4> frames;
+    const uint32_t ids[] = {0x0600, 0x1400, 0x1402, 0x2002};
+    for (size_t i = 0; i < frames.size(); ++i) {
+        frames[i].id = ids[i];
+        frames[i].extended = true;
+        frames[i].dlc = 8;
+    }
+    frames[0].data[4] = static_cast<uint8_t>((cycle % 15) << 4);                // AliveCounter
+    frames[1].data = {0xD0, 0x07, 0x88, 0x13, 0xE8, 0x03, 0xFF, 0xFF};           // 200 A, 500 V, 100 kW
+    const uint16_t current = static_cast<uint16_t>(32500 + cycle % 100);
+    frames[2].data = {static_cast<uint8_t>(current), static_cast<uint8_t>(current >> 8),
+                      0xA0, 0x0F, 0x01, 0x01, 0xFF, 0xFF};                       // ~400 V, Ready
+    frames[3].data[0] = 1;                                                       // STATUS_OK
+    return frames;
+}
+
+std::string workerLabel(const ChargerFleet::Statistics& stats)
+{
+    const double stolen = stats.tasksExecuted
+        ? 100.0 * static_cast<double>(stats.tasksStolen) / static_cast<double>(stats.tasksExecuted) : 0.0;
+    return "workers=" + std::to_string(stats.workerCount)
+         + " stolen=" + std::to_string(static_cast<int>(stolen)) + "%";
+}
+
+constexpr int CyclicMessages = 6; // VCU messages per module, see ChargeModule::txSchedule()
+
+} // namespace
+
+/// Throughput: each iteration is one bus cycle of work for every module, run as
+/// fast as the pool allows — 4 RX frames, the 6 cyclic sends and 2 timer ticks
+void BM_FleetCycle(State& state)
+{
+    const int modules = static_cast<int>(state.arg());
+    Fleet f(modules);
+    for (int i = 0; i < modules; ++i) {
+        f.fleet.module(i)->start(); // let serviceTx() send; no dispatcher thread
+    }
+
+    uint32_t cycle = 0;
+    while (state.keepRunning()) {
+        const auto frames = cmsCycle(cycle++);
+        for (int i = 0; i < modules; ++i) {
+            for (const auto& frame : frames) {
+                f.fleet.postFrame(i, frame);
+            }
+            f.fleet.postCommand(i, [](ChargeModule& module) {
+                for (int entry = 0; entry < CyclicMessages; ++entry) module.serviceTx(entry);
+                module.serviceTimers();
+                module.serviceTimers();
+            });
+        }
+        f.fleet.waitIdle();
+    }
+    state.setItemsProcessed(state.iterations() * modules * (4 + CyclicMessages));
+    state.setLabel(workerLabel(f.fleet.statistics()));
+}
+CCS_BENCHMARK(BM_FleetCycle, 1, 2, 4, 8, 16, 32, 64, 128, 256);
+
+/// Real time: the fleet runs its own schedule while every module receives one
+/// CMS cycle per 100 ms. Time per iteration is the cycle; the label shows how
+/// late the dispatcher and the workers ran.
+void BM_FleetRealtime(State& state)
+{
+    const int modules = static_cast<int>(state.arg());
+    Fleet f(modules);
+    f.fleet.start();
+
+    auto next = std::chrono::steady_clock::now();
+    uint32_t cycle = 0;
+    while (state.keepRunning()) {
+        const auto frames = cmsCycle(cycle++);
+        for (int i = 0; i < modules; ++i) {
+            for (const auto& frame : frames) {
+                f.fleet.postFrame(i, frame);
+            }
+        }
+        next += std::chrono::milliseconds(100);
+        std::this_thread::sleep_until(next);
+    }
+    f.fleet.stop();
+
+    const auto stats = f.fleet.statistics();
+    uint64_t written = 0;
+    for (const auto& bus : f.buses) written += bus->written;
+    state.setItemsProcessed(static_cast<int64_t>(stats.rxFrames + written));
+    state.setLabel(workerLabel(stats)
+                   + " jitter_max_us=" + std::to_string(stats.maxDispatchJitterUs)
+                   + " queue_max_us=" + std::to_string(stats.maxQueueDelayUs)
+                   + " missed=" + std::to_string(stats.txMissed));
+}
+CCS_BENCHMARK(BM_FleetRealtime, 1, 8, 32, 128, 256);
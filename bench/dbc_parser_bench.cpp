@@ -0,0 +1,131 @@
+#include "bench.h"
+#include "dbc/dbc_parser.h"
+#include <QThread>
+
+#ifndef CCS_BENCH_DBC
+#define CCS_BENCH_DBC "ISC_CMS_Automotive.dbc"
+#endif
+
+using namespace ccs;
+using namespace ccs::bench;
+
+namespace {
+
+/// Whole-vehicle sized DBC: every message has 8 signals, a comment, cycle time,
+/// a start value and a value table, so all cross-reference kinds are exercised.
+QString syntheticDbc(int messageCount)
+{
+    QString text;
+    QString comments;
+    QString attributes;
+    QString values;
+
+    text += "VERSION \"\"\n\nBU_: VCU CMS\n\n";
+    for (int i = 0; i < messageCount; ++i) {
+        uint32_t rawId = 0x80000000u | (0x100000u + static_cast<uint32_t>(i));
+        text += QString("BO_ %1 Msg%2: 8 VCU\n").arg(rawId).arg(i);
+        for (int s = 0; s < 8; ++s) {
+            text += QString(" SG_ Msg%1_Sig%2 : %3|8@1+ (0.5,0) [0|127] \"V\"  CMS\n").arg(i).arg(s).arg(s * 8);
+        }
+        text += "\n";
+
+        comments += QString("CM_ BO_ %1 \"Synthetic message %2\";\n").arg(rawId).arg(i);
+        comments += QString("CM_ SG_ %1 Msg%2_Sig0 \"Synthetic signal\";\n").arg(rawId).arg(i);
+        attributes += QString("BA_ \"GenMsgCycleTime\" BO_ %1 100;\n").arg(rawId);
+        attributes += QString("BA_ \"GenSigStartValue\" SG_ %1 Msg%2_Sig1 255;\n").arg(rawId).arg(i);
+        values += QString("VAL_ %1 Msg%2_Sig2 0 \"Off\" 1 \"On\" 255 \"SNA\" ;\n").arg(rawId).arg(i);
+    }
+    text += comments;
+    text += attributes;
+    text += values;
+    return text;
+}
+
+void BM_ParseSynthetic10k(State& state)
+{
+    static const QString text = syntheticDbc(10000);
+    int threads = static_cast<int>(state.arg());
+    if (threads > QThread::idealThreadCount()) {
+        state.setLabel("(more threads than cores)");
+    }
+    while (state.keepRunning()) {
+        DbcParser parser;
+        parser.setMaxThreads(threads);
+        parser.parseText(text);
+        doNotOptimize(parser.database().messages.size());
+    }
+    state.setItemsProcessed(state.iterations() * 10000);
+}
+CCS_BENCHMARK(BM_ParseSynthetic10k, 1, 2, 4, 8, 16);
+
+/// Default thread count, arg = number of messages
+void BM_ParseSynthetic(State& state)
+{
+    const int messages = static_cast<int>(state.arg());
+    const QString text = syntheticDbc(messages);
+    while (state.keepRunning()) {
+        DbcParser parser;
+        parser.parseText(text);
+        doNotOptimize(parser.database().messages.size());
+    }
+    state.setItemsProcessed(state.iterations() * messages);
+}
+CCS_BENCHMARK(BM_ParseSynthetic, 100, 1000, 10000, 50000);
+
+/// Includes reading the file, like ChargeModule::loadDbc
+void BM_ParseShippedDbc(State& state)
+{
+    bool ok = true;
+    while (state.keepRunning()) {
+        DbcParser parser;
+        ok = parser.parse(CCS_BENCH_DBC) && ok;
+        doNotOptimize(parser.database().messages.size());
+    }
+    if (!ok) state.setLabel("(" CCS_BENCH_DBC " not found)");
+}
+CCS_BENCHMARK(BM_ParseShippedDbc);
+
+const DbcDatabase& shippedDatabase()
+{
+    static DbcParser parser;
+    static bool parsed = parser.parse(CCS_BENCH_DBC);
+    (void)parsed;
+    return parser.database();
+}
+
+void BM_FindMessage(State& state)
+{
+    const DbcDatabase& db = shippedDatabase();
+    QVector<uint32_t> ids;
+    for (auto it = db.messages.cbegin(); it != db.messages.cend(); ++it) ids.append(it.key());
+    if (ids.isEmpty()) ids.append(0);
+
+    int i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(db.findMessage(ids[i]));
+        if (++i == ids.size()) i = 0;
+    }
+    state.setItemsProcessed(state.iterations());
+}
+CCS_BENCHMARK(BM_FindMessage);
+
+/// Every (message, signal name) pair of the database in turn
+void BM_FindSignal(State& state)
+{
+    const DbcDatabase& db = shippedDatabase();
+    QVector<QPair<uint32_t, QString>> lookups;
+    for (auto it = db.messages.cbegin(); it != db.messages.cend(); ++it) {
+        for (const auto& sig : it.value().dbcSignals) lookups.append({it.key(), sig.name});
+    }
+    if (lookups.isEmpty()) lookups.append({0, QString()});
+
+    int i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(db.findSignal(lookups[i].first, lookups[i].second));
+        if (++i == lookups.size()) i = 0;
+    }
+    state.setItemsProcessed(state.iterations());
+}
+CCS_BENCHMARK(BM_FindSignal);
+
+} // namespace
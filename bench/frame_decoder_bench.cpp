@@ -0,0 +1,95 @@
+#include "bench.h"
+#include "core/frame_decoder.h"
+#include "dbc/dbc_parser.h"
+#include "dbc/signal_codec.h"
+#include <QHash>
+#include <cstring>
+
+#ifndef CCS_BENCH_DBC
+#define CCS_BENCH_DBC "ISC_CMS_Automotive.dbc"
+#endif
+
+using namespace ccs;
+using namespace ccs::bench;
+
+namespace {
+
+const DbcDatabase& shippedDatabase()
+{
+    static DbcParser parser;
+    static bool parsed = parser.parse(CCS_BENCH_DBC);
+    (void)parsed;
+    return parser.database();
+}
+
+/// A bus-log shape over every message of the shipped DBC, round robin.
+/// arg 0: every payload differs from the last one with its ID (all decoded);
+/// arg 1: the payload of each ID never changes (all skipped as repeats).
+std::vector<CanFrame> busFrames(bool repeated)
+{
+    constexpr int Frames = 4096;
+    std::vector<CanFrame> frames;
+    const QList<DbcMessage> messages = shippedDatabase().messages.values();
+    if (messages.isEmpty()) return frames;
+    frames.reserve(Frames);
+    for (int i = 0; i < Frames; ++i) {
+        const DbcMessage& msg = messages[i % messages.size()];
+        CanFrame frame;
+        frame.id = msg.canId;
+        frame.extended = msg.extended;
+        frame.dlc = msg.dlc;
+        for (size_t b = 0; b < frame.data.size(); ++b) {
+            frame.data[b] = static_cast<uint8_t>(repeated ? b * 29 : (i / messages.size()) * 31 + b * 7);
+        }
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+/// The Qt receive path ChargeModule ran before core_layer: QMap message lookup,
+/// QHash repeat check, SignalCodec decode. No SignalTable upkeep, so it does less work.
+void BM_RxPathQt(State& state)
+{
+    struct Payload { uint64_t data; uint8_t dlc; };
+    const auto frames = busFrames(state.arg() != 0);
+    SignalCodec codec(shippedDatabase());
+    SignalBuffer buffer;
+    buffer.resize(shippedDatabase());
+    QHash<uint32_t, Payload> lastPayload;
+    while (state.keepRunning()) {
+        for (const auto& frame : frames) {
+            const DbcMessage* msg = shippedDatabase().findMessage(frame.id);
+            if (!msg) continue;
+            uint64_t data;
+            std::memcpy(&data, frame.data.data(), sizeof(data));
+            auto it = lastPayload.find(frame.id);
+            if (it != lastPayload.end() && it->data == data && it->dlc == frame.dlc) continue;
+            lastPayload.insert(frame.id, {data, frame.dlc});
+            codec.decodeInto(frame, buffer);
+        }
+        doNotOptimize(buffer.physical.data());
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+    state.setLabel(state.arg() ? "repeated" : "unique");
+}
+
+/// The same frames through core_layer's FrameDecoder, SignalTable update included
+void BM_RxPathCore(State& state)
+{
+    const auto frames = busFrames(state.arg() != 0);
+    FrameDecoder decoder;
+    decoder.setLayout(shippedDatabase().layout());
+    while (state.keepRunning()) {
+        for (const auto& frame : frames) {
+            doNotOptimize(decoder.process(frame).outcome);
+        }
+        doNotOptimize(decoder.values().physical.data());
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+    state.setLabel(state.arg() ? "repeated" : "unique");
+}
+
+CCS_BENCHMARK(BM_RxPathQt, 0, 1);
+CCS_BENCHMARK(BM_RxPathCore, 0, 1);
+
+} // namespace
@@ -0,0 +1,227 @@
+#include "bench.h"
+#include "dbc/dbc_parser.h"
+#include "dbc/signal_codec.h"
+#include <algorithm>
+#include <array>
+
+using namespace ccs;
+using namespace ccs::bench;
+
+namespace {
+
+/// Signal of the requested width starting at the first payload bit:
+/// Intel LSB at bit 0, Motorola MSB at bit 7 (byte 0), so 1..64 bits all fit.
+DbcSignal makeSignal(uint32_t bitLength, bool littleEndian)
+{
+    DbcSignal sig;
+    sig.name = "Bench";
+    sig.bitLength = bitLength;
+    sig.littleEndian = littleEndian;
+    sig.startBit = littleEndian ? 0 : 7;
+    sig.layoutValid = true;
+    DbcParser::compileExtractionPlan(sig);
+    return sig;
+}
+
+/// One 8-signal message with a value table, in the shape of the CMS status frames
+const DbcDatabase& statusDatabase()
+{
+    static DbcParser parser;
+    static bool parsed = parser.parseText(
+        "BO_ 256 Status: 8 CMS\n"
+        " SG_ State : 0|4@1+ (1,0) [0|15] \"\" VCU\n"
+        " SG_ Alive : 4|4@1+ (1,0) [0|15] \"\" VCU\n"
+        " SG_ Voltage : 8|16@1+ (0.1,0) [0|1500] \"V\" VCU\n"
+        " SG_ Current : 24|13@1+ (0.125,-500) [-500|500] \"A\" VCU\n"
+        " SG_ Power : 47|16@0+ (10,0) [0|500000] \"W\" VCU\n"
+        " SG_ Duty : 56|5@1+ (5,0) [0|100] \"%\" VCU\n"
+        " SG_ Iso : 61|3@1+ (1,0) [0|7] \"\" VCU\n"
+        " SG_ Code : 37|3@1+ (1,0) [0|7] \"\" VCU\n"
+        "\n"
+        "VAL_ 256 State 0 \"Init\" 1 \"Ready\" 2 \"Charge\" 15 \"SNA\" ;\n");
+    (void)parsed;
+    return parser.database();
+}
+
+std::array<uint8_t, 8> payload()
+{
+    return {0x3C, 0xA5, 0x5A, 0xC3, 0x0F, 0xF0, 0x96, 0x69};
+}
+
+template <bool LittleEndian>
+void extractBitLoop(State& state)
+{
+    DbcSignal sig = makeSignal(static_cast<uint32_t>(state.arg()), LittleEndian);
+    auto data = payload();
+    while (state.keepRunning()) {
+        doNotOptimize(data);
+        doNotOptimize(SignalCodec::extractBits(data.data(), sig.startBit, sig.bitLength, sig.littleEndian));
+    }
+}
+
+template <bool LittleEndian>
+void extractPlanned(State& state)
+{
+    DbcSignal sig = makeSignal(static_cast<uint32_t>(state.arg()), LittleEndian);
+    auto data = payload();
+    while (state.keepRunning()) {
+        doNotOptimize(data);
+        doNotOptimize(SignalCodec::extractPlanned(data.data(), sig));
+    }
+}
+
+template <bool LittleEndian>
+void insertBitLoop(State& state)
+{
+    DbcSignal sig = makeSignal(static_cast<uint32_t>(state.arg()), LittleEndian);
+    auto data = payload();
+    uint64_t value = 0x123456789ABCDEF0ULL;
+    while (state.keepRunning()) {
+        SignalCodec::insertBits(data.data(), sig.startBit, sig.bitLength, sig.littleEndian, value++);
+        doNotOptimize(data);
+    }
+}
+
+template <bool LittleEndian>
+void insertPlanned(State& state)
+{
+    DbcSignal sig = makeSignal(static_cast<uint32_t>(state.arg()), LittleEndian);
+    auto data = payload();
+    uint64_t value = 0x123456789ABCDEF0ULL;
+    while (state.keepRunning()) {
+        SignalCodec::insertPlanned(data.data(), sig, value++);
+        doNotOptimize(data);
+    }
+}
+
+void BM_DecodeMessage(State& state)
+{
+    SignalCodec codec(statusDatabase());
+    CanFrame frame;
+    frame.id = 256;
+    auto data = payload();
+    std::copy(data.begin(), data.end(), frame.data.begin());
+    while (state.keepRunning()) {
+        doNotOptimize(codec.decode(frame));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_DecodeInto(State& state)
+{
+    SignalCodec codec(statusDatabase());
+    SignalBuffer buffer;
+    buffer.resize(statusDatabase());
+    CanFrame frame;
+    frame.id = 256;
+    auto data = payload();
+    std::copy(data.begin(), data.end(), frame.data.begin());
+    while (state.keepRunning()) {
+        doNotOptimize(codec.decodeInto(frame, buffer));
+        doNotOptimize(buffer.physical[0]);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+/// arg 0 = Intel signal (Voltage), 1 = Motorola signal (Power)
+const DbcSignal& statusSignal(int64_t motorola)
+{
+    return *statusDatabase().findSignal(256, motorola ? "Power" : "Voltage");
+}
+
+void BM_DecodeSignal(State& state)
+{
+    SignalCodec codec(statusDatabase());
+    const DbcSignal& sig = statusSignal(state.arg());
+    CanFrame frame;
+    frame.id = 256;
+    frame.data = payload();
+    while (state.keepRunning()) {
+        doNotOptimize(codec.decodeSignal(frame, sig));
+    }
+    state.setLabel(sig.littleEndian ? "Intel" : "Motorola");
+}
+
+void BM_EncodeSignal(State& state)
+{
+    SignalCodec codec(statusDatabase());
+    const DbcSignal& sig = statusSignal(state.arg());
+    CanFrame frame;
+    frame.id = 256;
+    double value = sig.minimum;
+    const double step = (sig.maximum - sig.minimum) / 1024.0;
+    while (state.keepRunning()) {
+        codec.encodeSignal(frame, sig, value);
+        doNotOptimize(frame.data);
+        value = (value + step > sig.maximum) ? sig.minimum : value + step;
+    }
+    state.setLabel(sig.littleEndian ? "Intel" : "Motorola");
+}
+
+/// Recorded-log shape: many payloads of one message, decoded per frame...
+void BM_DecodeFrameLoop(State& state)
+{
+    constexpr int Frames = 4096;
+    SignalCodec codec(statusDatabase());
+    SignalBuffer buffer;
+    buffer.resize(statusDatabase());
+    QVector<CanFrame> frames(Frames);
+    for (int i = 0; i < Frames; ++i) {
+        frames[i].id = 256;
+        frames[i].data = payload();
+        frames[i].data[0] = static_cast<uint8_t>(i);
+    }
+    while (state.keepRunning()) {
+        for (const auto& frame : frames) {
+            codec.decodeInto(frame, buffer);
+        }
+        doNotOptimize(buffer.physical[0]);
+    }
+    state.setItemsProcessed(state.iterations() * Frames);
+}
+
+/// ...versus one columnar batch call; arg selects the BatchKernel
+void BM_DecodeBatch(State& state)
+{
+    constexpr int Frames = 4096;
+    SignalCodec codec(statusDatabase());
+    QVector<std::array<uint8_t, 8>> payloads(Frames);
+    for (int i = 0; i < Frames; ++i) {
+        payloads[i] = payload();
+        payloads[i][0] = static_cast<uint8_t>(i);
+    }
+    BatchColumns columns;
+    auto kernel = static_cast<BatchKernel>(state.arg());
+    while (state.keepRunning()) {
+        codec.decodeBatch(256, payloads.constData(), Frames, columns, kernel);
+        doNotOptimize(columns.physical[0]);
+    }
+    state.setItemsProcessed(state.iterations() * Frames);
+}
+
+void BM_ExtractBitLoopIntel(State& s)    { extractBitLoop<true>(s); }
+void BM_ExtractBitLoopMotorola(State& s) { extractBitLoop<false>(s); }
+void BM_ExtractPlannedIntel(State& s)    { extractPlanned<true>(s); }
+void BM_ExtractPlannedMotorola(State& s) { extractPlanned<false>(s); }
+void BM_InsertBitLoopIntel(State& s)     { insertBitLoop<true>(s); }
+void BM_InsertBitLoopMotorola(State& s)  { insertBitLoop<false>(s); }
+void BM_InsertPlannedIntel(State& s)     { insertPlanned<true>(s); }
+void BM_InsertPlannedMotorola(State& s)  { insertPlanned<false>(s); }
+
+CCS_BENCHMARK(BM_DecodeSignal, 0, 1);
+CCS_BENCHMARK(BM_EncodeSignal, 0, 1);
+CCS_BENCHMARK(BM_DecodeMessage);
+CCS_BENCHMARK(BM_DecodeInto);
+CCS_BENCHMARK(BM_DecodeFrameLoop);
+CCS_BENCHMARK(BM_DecodeBatch, static_cast<int>(BatchKernel::Scalar),
+              static_cast<int>(BatchKernel::Sse41), static_cast<int>(BatchKernel::Avx2));
+CCS_BENCHMARK(BM_ExtractBitLoopIntel, 1, 8, 12, 16, 32, 48, 64);
+CCS_BENCHMARK(BM_ExtractBitLoopMotorola, 1, 8, 12, 16, 32, 48, 64);
+CCS_BENCHMARK(BM_ExtractPlannedIntel, 1, 8, 12, 16, 32, 48, 64);
+CCS_BENCHMARK(BM_ExtractPlannedMotorola, 1, 8, 12, 16, 32, 48, 64);
+CCS_BENCHMARK(BM_InsertBitLoopIntel, 1, 8, 12, 16, 32, 48, 64);
+CCS_BENCHMARK(BM_InsertBitLoopMotorola, 1, 8, 12, 16, 32, 48, 64);
+CCS_BENCHMARK(BM_InsertPlannedIntel, 1, 8, 12, 16, 32, 48, 64);
+CCS_BENCHMARK(BM_InsertPlannedMotorola, 1, 8, 12, 16, 32, 48, 64);
+
+} // namespace
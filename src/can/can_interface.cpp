@@ -1,4 +1,5 @@
 #include "can/can_interface.h"
+#include "core/tsc_clock.h"
 #include <QDebug>
 #include <cstring>
 
@@ -71,6 +72,7 @@ bool SimulatedCanInterface::write(const CanFrame& frame)
         }
     }
 
+    QMutexLocker lock(&m_txQueueMutex);
     m_txQueue.push_back(frame);
     return true;
 }
@@ -98,6 +100,7 @@ void SimulatedCanInterface::onSimulationTick()
     if (!m_open) return;
 
     auto now = std::chrono::steady_clock::now();
+    const uint64_t ticks = TscClock::now();
 
     // Simulate ChargeInfo (0x0600) - 100ms cycle
     {
@@ -106,6 +109,7 @@ void SimulatedCanInterface::onSimulationTick()
         f.extended = true;
         f.dlc = 8;
         f.timestamp = now;
+        f.rxTicks = ticks;
         std::memset(f.data.data(), 0, 8);
 
         // ControlPilotDutyCycle: bits 0-6, value 5 (5%)
@@ -141,6 +145,7 @@ void SimulatedCanInterface::onSimulationTick()
         f.extended = true;
         f.dlc = 8;
         f.timestamp = now;
+        f.rxTicks = ticks;
         std::memset(f.data.data(), 0, 8);
 
         // EVSEPresentCurrent: bits 0-15, scale 0.1, offset -3250
@@ -183,6 +188,7 @@ void SimulatedCanInterface::onSimulationTick()
         f.extended = true;
         f.dlc = 8;
         f.timestamp = now;
+        f.rxTicks = ticks;
         std::memset(f.data.data(), 0, 8);
 
         // EVSEMaxCurrent: bits 0-15, scale 0.1 → 200A = 2000
@@ -214,6 +220,7 @@ void SimulatedCanInterface::onSimulationTick()
         f.extended = true;
         f.dlc = 8;
         f.timestamp = now;
+        f.rxTicks = ticks;
         std::memset(f.data.data(), 0, 8);
         // ErrorCodeLevel0 = 1 (STATUS_OK)
         f.data[0] = 1;
@@ -222,14 +229,14 @@ void SimulatedCanInterface::onSimulationTick()
     }
 
     // Simulate SoftwareInfo (0x2001) every N ticks
-    static int swInfoCounter = 0;
-    if (++swInfoCounter >= 100) { // every 10s
-        swInfoCounter = 0;
+    if (++m_swInfoCounter >= 100) { // every 10s
+        m_swInfoCounter = 0;
         CanFrame f;
         f.id = 0x2001;
         f.extended = true;
         f.dlc = 8;
         f.timestamp = now;
+        f.rxTicks = ticks;
         std::memset(f.data.data(), 0, 8);
         f.data[0] = 1; // Major
         f.data[1] = 2; // Minor
@@ -239,9 +246,8 @@ void SimulatedCanInterface::onSimulationTick()
     }
 
     // Auto-advance state machine in simulation for demonstration
-    static int stateTimer = 0;
-    stateTimer++;
-    if (m_stateMachineState == 0 && stateTimer > 10) {
+    m_stateTimer++;
+    if (m_stateMachineState == 0 && m_stateTimer > 10) {
         m_stateMachineState = 1; // Init
     }
 }
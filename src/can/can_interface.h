@@ -85,7 +85,11 @@ private:
     QString m_lastError;
     QTimer* m_simTimer = nullptr;
     uint8_t m_aliveCounter = 0;
-    uint8_t m_stateMachineState = 0; // Default
+    int m_swInfoCounter = 0; // per instance: a ChargerFleet simulates many buses
+    int m_stateTimer = 0;
+    // write() may be called from ChargeModule's TX scheduler thread
+    std::atomic<uint8_t> m_stateMachineState{0}; // Default
+    QMutex m_txQueueMutex;
     std::vector<CanFrame> m_txQueue; // frames we sent (for echo-back in sim)
 };
 
@@ -1,4 +1,5 @@
 #include "can/pcan_driver.h"
+#include "core/tsc_clock.h"
 #include <QDebug>
 #include <QCoreApplication>
 #include <thread>
@@ -182,6 +183,7 @@ void PcanDriver::pollLoop()
             frame.dlc = msg.LEN;
             std::memcpy(frame.data.data(), msg.DATA, std::min<uint8_t>(msg.LEN, 8));
             frame.timestamp = std::chrono::steady_clock::now();
+            frame.rxTicks = TscClock::now();
 
             emit frameReceived(frame);
         }
@@ -0,0 +1,89 @@
+#include "core/bit_codec.h"
+
+namespace ccs::bits {
+
+uint64_t extract(const uint8_t* data, uint32_t startBit, uint32_t bitLength, bool littleEndian)
+{
+    uint64_t result = 0;
+
+    if (littleEndian) {
+        // Intel byte order: startBit is the LSB position
+        for (uint32_t i = 0; i < bitLength; ++i) {
+            uint32_t bitPos = startBit + i;
+            uint32_t byteIdx = bitPos / 8;
+            uint32_t bitIdx = bitPos % 8;
+            if (byteIdx < 8) {
+                if (data[byteIdx] & (1 << bitIdx)) {
+                    result |= (1ULL << i);
+                }
+            }
+        }
+    }
+    else {
+        // Motorola byte order: startBit is the MSB position
+        // Convert Motorola start bit to bit positions
+        for (uint32_t i = 0; i < bitLength; ++i) {
+            uint32_t byteNum = startBit / 8;
+            uint32_t bitNum = startBit % 8;
+
+            // Calculate the actual bit position for the i-th bit (MSB first)
+            int srcByte = static_cast<int>(byteNum);
+            int srcBit = static_cast<int>(bitNum) - static_cast<int>(i);
+
+            while (srcBit < 0) {
+                srcByte++;
+                srcBit += 8;
+            }
+
+            if (srcByte < 8 && srcByte >= 0) {
+                if (data[srcByte] & (1 << srcBit)) {
+                    result |= (1ULL << (bitLength - 1 - i));
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+void insert(uint8_t* data, uint32_t startBit, uint32_t bitLength, bool littleEndian, uint64_t value)
+{
+    if (littleEndian) {
+        for (uint32_t i = 0; i < bitLength; ++i) {
+            uint32_t bitPos = startBit + i;
+            uint32_t byteIdx = bitPos / 8;
+            uint32_t bitIdx = bitPos % 8;
+            if (byteIdx < 8) {
+                if (value & (1ULL << i)) {
+                    data[byteIdx] |= (1 << bitIdx);
+                } else {
+                    data[byteIdx] &= ~(1 << bitIdx);
+                }
+            }
+        }
+    }
+    else {
+        for (uint32_t i = 0; i < bitLength; ++i) {
+            uint32_t byteNum = startBit / 8;
+            uint32_t bitNum = startBit % 8;
+
+            int srcByte = static_cast<int>(byteNum);
+            int srcBit = static_cast<int>(bitNum) - static_cast<int>(i);
+
+            while (srcBit < 0) {
+                srcByte++;
+                srcBit += 8;
+            }
+
+            if (srcByte < 8 && srcByte >= 0) {
+                if (value & (1ULL << (bitLength - 1 - i))) {
+                    data[srcByte] |= (1 << srcBit);
+                } else {
+                    data[srcByte] &= ~(1 << srcBit);
+                }
+            }
+        }
+    }
+}
+
+} // namespace ccs::bits
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+namespace ccs::bits {
+
+inline uint64_t byteSwap64(uint64_t v)
+{
+#if defined(_MSC_VER)
+    return _byteswap_uint64(v);
+#else
+    return __builtin_bswap64(v);
+#endif
+}
+
+/// Payload as one 64-bit word: little-endian for Intel signals, big-endian for Motorola
+inline uint64_t loadWord(const uint8_t* data, bool littleEndian)
+{
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    bool swap = littleEndian ? (std::endian::native == std::endian::big)
+                             : (std::endian::native == std::endian::little);
+    return swap ? byteSwap64(word) : word;
+}
+
+inline void storeWord(uint8_t* data, bool littleEndian, uint64_t word)
+{
+    bool swap = littleEndian ? (std::endian::native == std::endian::big)
+                             : (std::endian::native == std::endian::little);
+    if (swap) word = byteSwap64(word);
+    std::memcpy(data, &word, sizeof(word));
+}
+
+/// Reference bit loops; startBit is the LSB for Intel and the MSB for Motorola signals
+uint64_t extract(const uint8_t* data, uint32_t startBit, uint32_t bitLength, bool littleEndian);
+void insert(uint8_t* data, uint32_t startBit, uint32_t bitLength, bool littleEndian, uint64_t value);
+
+/// Word-level extract/insert with a precompiled plan (see DbcParser::compileExtractionPlan);
+/// data must hold 8 bytes
+inline uint64_t extractPlanned(const uint8_t* data, bool littleEndian, uint8_t shift, uint64_t mask)
+{
+    return (loadWord(data, littleEndian) >> shift) & mask;
+}
+
+inline void insertPlanned(uint8_t* data, bool littleEndian, uint8_t shift, uint64_t mask, uint64_t value)
+{
+    uint64_t word = loadWord(data, littleEndian);
+    uint64_t placed = mask << shift;
+    word = (word & ~placed) | ((value << shift) & placed);
+    storeWord(data, littleEndian, word);
+}
+
+inline double rawToPhysical(uint64_t raw, double factor, double offset, bool isSigned, uint32_t bitLength)
+{
+    if (isSigned && bitLength < 64) {
+        // Sign-extend
+        uint64_t signBit = 1ULL << (bitLength - 1);
+        if (raw & signBit) {
+            // Negative value - sign extend
+            int64_t signedRaw = static_cast<int64_t>(raw | (~0ULL << bitLength));
+            return static_cast<double>(signedRaw) * factor + offset;
+        }
+    }
+    return static_cast<double>(raw) * factor + offset;
+}
+
+inline uint64_t physicalToRaw(double physical, double factor, double offset)
+{
+    if (factor == 0.0) return 0;
+    double raw = std::round((physical - offset) / factor);
+    // Negative raw values (signed signals) go through int64 to get two's complement
+    if (raw < 0.0) return static_cast<uint64_t>(static_cast<int64_t>(raw));
+    return static_cast<uint64_t>(raw);
+}
+
+} // namespace ccs::bits
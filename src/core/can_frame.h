@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <chrono>
+
+namespace ccs {
+
+struct CanFrame {
+    uint32_t id = 0;
+    bool extended = false;
+    uint8_t dlc = 0;
+    std::array<uint8_t, 8> data{};
+    std::chrono::steady_clock::time_point timestamp;
+    uint64_t rxTicks = 0; // TscClock at driver receive, 0 when not stamped
+};
+
+enum class CanStatus {
+    Ok,
+    BusOff,
+    BusWarning,
+    BusPassive,
+    Error,
+    Disconnected
+};
+
+inline const char* canStatusToString(CanStatus s) {
+    switch (s) {
+        case CanStatus::Ok:           return "OK";
+        case CanStatus::BusOff:       return "Bus Off";
+        case CanStatus::BusWarning:   return "Bus Warning";
+        case CanStatus::BusPassive:   return "Bus Passive";
+        case CanStatus::Error:        return "Error";
+        case CanStatus::Disconnected: return "Disconnected";
+    }
+    return "Unknown";
+}
+
+} // namespace ccs
@@ -0,0 +1,178 @@
+#include "core/dbc_layout.h"
+#include <algorithm>
+
+namespace ccs {
+
+namespace {
+
+/// Fibonacci hashing: CAN IDs are often consecutive, which would cluster under a plain mask
+inline size_t slotFor(uint32_t canId, size_t mask)
+{
+    return static_cast<size_t>((static_cast<uint64_t>(canId) * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+} // namespace
+
+void DbcLayout::addMessage(MessageLayout message)
+{
+    message.firstHandle = signalCount();
+    message.signalCount = 0;
+    const uint32_t canId = message.canId;
+    m_messages.push_back(std::move(message));
+
+    if (m_messages.size() * 2 > m_slots.size()) {
+        grow();
+    } else {
+        insertSlot(canId, messageCount() - 1);
+    }
+}
+
+int DbcLayout::addSignal(SignalLayout signal, std::string name, std::optional<int64_t> snaValue)
+{
+    if (m_messages.empty()) return -1;
+    MessageLayout& message = m_messages.back();
+    const int index = message.signalCount;
+
+    // In bounds, and no bit shared with a signal that can be in the same frame
+    uint64_t mask = 0;
+    const uint32_t payloadBits = std::min<uint32_t>(message.dlc, 8) * 8;
+    if (!signalBitMask(signal.startBit, signal.bitLength, signal.littleEndian, payloadBits, mask)) {
+        mask = 0;
+    }
+    signal.layoutValid = mask != 0;
+    for (int j = 0; j < index && mask != 0; ++j) {
+        const size_t other = static_cast<size_t>(message.firstHandle + j);
+        if ((m_bitMasks[other] & mask) == 0 || !coPresent(message, index, j)) continue;
+        signal.layoutValid = false;
+        m_signals[other].layoutValid = false;
+    }
+    signal.planShift = 0;
+    signal.planMask = 0;
+    if (mask != 0) {
+        compileExtractionPlan(signal.startBit, signal.bitLength, signal.littleEndian, signal.planShift, signal.planMask);
+    }
+
+    signal.hasSna = snaValue.has_value();
+    signal.snaRaw = snaValue ? valueTableRaw(*snaValue, signal.bitLength) : 0;
+
+    m_signals.push_back(signal);
+    m_signalNames.push_back(std::move(name));
+    m_bitMasks.push_back(mask);
+    ++message.signalCount;
+    return signalCount() - 1;
+}
+
+bool DbcLayout::signalBitMask(uint32_t startBit, uint32_t bitLength, bool littleEndian,
+                              uint32_t payloadBits, uint64_t& mask)
+{
+    mask = 0;
+    if (bitLength == 0 || bitLength > 64) return false;
+
+    if (littleEndian) {
+        // Intel: contiguous run upwards from the LSB at startBit
+        if (startBit + bitLength > payloadBits) return false;
+        mask = (bitLength >= 64) ? ~0ULL : (((1ULL << bitLength) - 1) << startBit);
+        return true;
+    }
+
+    // Motorola: MSB at startBit, walking down within a byte then into the next byte
+    int byte = static_cast<int>(startBit / 8);
+    int bit = static_cast<int>(startBit % 8);
+    for (uint32_t i = 0; i < bitLength; ++i) {
+        const uint32_t pos = static_cast<uint32_t>(byte * 8 + bit);
+        if (pos >= payloadBits) return false;
+        mask |= (1ULL << pos);
+        if (--bit < 0) {
+            bit = 7;
+            ++byte;
+        }
+    }
+    return true;
+}
+
+void DbcLayout::compileExtractionPlan(uint32_t startBit, uint32_t bitLength, bool littleEndian,
+                                      uint8_t& planShift, uint64_t& planMask)
+{
+    planMask = (bitLength >= 64) ? ~0ULL : ((1ULL << bitLength) - 1);
+    if (littleEndian) {
+        // Little-endian word: payload bit n is word bit n, the LSB sits at startBit
+        planShift = static_cast<uint8_t>(startBit);
+    } else {
+        // Big-endian word: byte k occupies word bits (7 - k) * 8 .. +7, and the
+        // Motorola sawtooth becomes one contiguous run ending at the MSB (startBit)
+        const uint32_t msb = (7 - startBit / 8) * 8 + startBit % 8;
+        planShift = static_cast<uint8_t>(msb + 1 - bitLength);
+    }
+}
+
+uint64_t DbcLayout::valueTableRaw(int64_t key, uint32_t bitLength)
+{
+    const uint64_t rawMask = (bitLength >= 64) ? ~0ULL : ((1ULL << bitLength) - 1);
+    return static_cast<uint64_t>(key) & rawMask;
+}
+
+int DbcLayout::messageIndex(uint32_t canId) const
+{
+    if (m_slots.empty()) return -1;
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = slotFor(canId, mask);; i = (i + 1) & mask) {
+        const Slot& slot = m_slots[i];
+        if (slot.index < 0) return -1;
+        if (slot.canId == canId) return slot.index;
+    }
+}
+
+int DbcLayout::signalHandle(uint32_t canId, std::string_view name) const
+{
+    const MessageLayout* msg = find(canId);
+    if (!msg) return -1;
+    for (int i = 0; i < msg->signalCount; ++i) {
+        if (m_signalNames[static_cast<size_t>(msg->firstHandle + i)] == name) return msg->firstHandle + i;
+    }
+    return -1;
+}
+
+bool DbcLayout::coPresent(const MessageLayout& message, int i, int j)
+{
+    if (message.plainSignals.empty() && message.muxGroups.empty()) return true;
+
+    auto isPlain = [&](int k) {
+        return std::find(message.plainSignals.cbegin(), message.plainSignals.cend(), k) != message.plainSignals.cend();
+    };
+    auto inGroup = [](const std::vector<int>& group, int k) {
+        return std::find(group.cbegin(), group.cend(), k) != group.cend();
+    };
+    // Plain signals share the frame with every listed signal; each mux group only with them
+    const bool plainI = isPlain(i);
+    const bool plainJ = isPlain(j);
+    for (const auto& group : message.muxGroups) {
+        const bool hasI = plainI || inGroup(group, i);
+        const bool hasJ = plainJ || inGroup(group, j);
+        if (hasI && hasJ) return true;
+    }
+    return plainI && plainJ;
+}
+
+void DbcLayout::insertSlot(uint32_t canId, int index)
+{
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = slotFor(canId, mask);; i = (i + 1) & mask) {
+        Slot& slot = m_slots[i];
+        if (slot.index < 0 || slot.canId == canId) {
+            slot = {canId, index}; // a repeated ID now names the later message
+            return;
+        }
+    }
+}
+
+void DbcLayout::grow()
+{
+    size_t size = 16;
+    while (size < m_messages.size() * 2) size *= 2;
+    m_slots.assign(size, Slot{});
+    for (int i = 0; i < messageCount(); ++i) {
+        insertSlot(m_messages[static_cast<size_t>(i)].canId, i);
+    }
+}
+
+} // namespace ccs
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ccs {
+
+/// What decoding one signal needs (see DbcSignal for the meaning of each field).
+/// planMask, snaRaw, planShift, layoutValid and hasSna are set by DbcLayout::addSignal().
+struct SignalLayout {
+    uint32_t startBit = 0;
+    uint32_t bitLength = 0;
+    double factor = 1.0;
+    double offset = 0.0;
+    uint64_t planMask = 0;
+    uint64_t snaRaw = 0;
+    uint8_t planShift = 0;
+    bool littleEndian = true;
+    bool isSigned = false;
+    bool layoutValid = false; // planShift/planMask apply; otherwise the bit loop decodes it
+    bool hasSna = false;
+};
+
+/// What decoding one message needs (see DbcMessage)
+struct MessageLayout {
+    uint32_t canId = 0;
+    bool extended = false;
+    uint8_t dlc = 0;
+    int cycleTimeMs = 0;
+    std::string name;
+    int firstHandle = 0;  // set by DbcLayout: handles firstHandle .. firstHandle + signalCount - 1
+    int signalCount = 0;  // counted by DbcLayout::addSignal()
+    int muxSignalIndex = -1;
+    std::vector<int> plainSignals;            // both empty: every signal is always present
+    std::vector<std::vector<int>> muxGroups;
+};
+
+/// Standard-C++ form of a DBC for the per-frame path: signal layouts and the message and
+/// signal names, but no comments or value tables. DbcDatabase::layout() builds one with
+/// the same signal handles as the database; a program without Qt can also fill one itself,
+/// since addSignal() derives the extraction plan and SNA value.
+/// find() is O(1): an open-addressed table keyed by CAN ID.
+class DbcLayout {
+public:
+    /// Append a message; the addSignal() calls that follow add its signals in order.
+    /// Fill its plainSignals/muxGroups first: they decide which signals may share bits.
+    void addMessage(MessageLayout message);
+    /// Next signal of the last message added; returns its handle. Computes planShift,
+    /// planMask and layoutValid (inside the DLC, no overlap with a co-present signal
+    /// added before it; an overlap clears the earlier signal's flag too). snaValue is
+    /// the key of the signal's "SNA" value-table entry, if it has one.
+    int addSignal(SignalLayout signal, std::string name, std::optional<int64_t> snaValue = std::nullopt);
+
+    /// Payload bits covered by a signal (bit n = byte * 8 + bit).
+    /// Returns false if any bit falls outside payloadBits.
+    static bool signalBitMask(uint32_t startBit, uint32_t bitLength, bool littleEndian,
+                              uint32_t payloadBits, uint64_t& mask);
+    /// planShift/planMask of a signal whose bits lie within the 8-byte payload
+    static void compileExtractionPlan(uint32_t startBit, uint32_t bitLength, bool littleEndian,
+                                      uint8_t& planShift, uint64_t& planMask);
+    /// Raw bit pattern of a value-table key: negative keys of signed signals are masked to bitLength
+    static uint64_t valueTableRaw(int64_t key, uint32_t bitLength);
+
+    const MessageLayout* find(uint32_t canId) const
+    {
+        const int index = messageIndex(canId);
+        return index >= 0 ? &m_messages[static_cast<size_t>(index)] : nullptr;
+    }
+    /// Position in messages(), -1 for an unknown ID
+    int messageIndex(uint32_t canId) const;
+
+    const std::vector<MessageLayout>& messages() const { return m_messages; }
+    int messageCount() const { return static_cast<int>(m_messages.size()); }
+    int signalCount() const { return static_cast<int>(m_signals.size()); }
+    const SignalLayout& signalAt(int handle) const { return m_signals[static_cast<size_t>(handle)]; }
+    const std::string& signalName(int handle) const { return m_signalNames[static_cast<size_t>(handle)]; }
+
+    /// Handle of a signal, or -1 if the message or signal does not exist
+    int signalHandle(uint32_t canId, std::string_view name) const;
+
+private:
+    struct Slot {
+        uint32_t canId = 0;
+        int index = -1; // -1 = empty
+    };
+
+    void insertSlot(uint32_t canId, int index);
+    void grow();
+    /// Whether signals i and j of message can be in the same frame
+    static bool coPresent(const MessageLayout& message, int i, int j);
+
+    std::vector<MessageLayout> m_messages;
+    std::vector<SignalLayout> m_signals;      // by handle, kept apart from the names so
+    std::vector<std::string> m_signalNames;   // decoding walks a dense array
+    std::vector<uint64_t> m_bitMasks;         // by handle, 0 for a signal outside its payload
+    std::vector<Slot> m_slots;                // power-of-two size, at most half full
+};
+
+} // namespace ccs
@@ -0,0 +1,77 @@
+#include "core/frame_decoder.h"
+#include "core/bit_codec.h"
+#include <cstring>
+
+namespace ccs {
+
+namespace {
+
+/// Single writer: a plain increment, not a locked read-modify-write
+inline void bump(std::atomic<uint64_t>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+void FrameDecoder::setLayout(DbcLayout layout)
+{
+    m_layout = std::move(layout);
+    m_values.resize(static_cast<size_t>(m_layout.signalCount()));
+    m_table.resize(m_layout);
+    m_lastPayload.assign(static_cast<size_t>(m_layout.messageCount()), Payload{});
+}
+
+FrameDecoder::Result FrameDecoder::process(const CanFrame& frame)
+{
+    const int index = m_layout.messageIndex(frame.id);
+    if (index < 0) return {};
+    const MessageLayout& msg = m_layout.messages()[static_cast<size_t>(index)];
+
+    uint64_t data;
+    std::memcpy(&data, frame.data.data(), sizeof(data));
+    Payload& last = m_lastPayload[static_cast<size_t>(index)];
+    if (last.seen && last.data == data && last.dlc == frame.dlc) {
+        bump(m_repeatedCount);
+        m_table.touch(msg, frame.timestamp);
+        return {Outcome::Repeated, &msg, index};
+    }
+    last = {data, frame.dlc, true};
+
+    bump(m_decodedCount);
+    decode(msg, frame.data.data());
+    m_table.update(msg, m_values.raw.data(), m_values.physical.data(), m_values.valid.data(), frame.timestamp);
+    return {Outcome::Decoded, &msg, index};
+}
+
+void FrameDecoder::decode(const MessageLayout& msg, const uint8_t* data)
+{
+    uint64_t* raw = m_values.raw.data();
+    double* physical = m_values.physical.data();
+    uint8_t* valid = m_values.valid.data();
+
+    auto decodeSlot = [&](int index) {
+        const int handle = msg.firstHandle + index;
+        const SignalLayout& sig = m_layout.signalAt(handle);
+        const uint64_t value = sig.layoutValid
+            ? bits::extractPlanned(data, sig.littleEndian, sig.planShift, sig.planMask)
+            : bits::extract(data, sig.startBit, sig.bitLength, sig.littleEndian);
+        raw[handle] = value;
+        physical[handle] = bits::rawToPhysical(value, sig.factor, sig.offset, sig.isSigned, sig.bitLength);
+        valid[handle] = (sig.hasSna && value == sig.snaRaw) ? 0 : 1;
+    };
+
+    if (msg.muxSignalIndex < 0) {
+        for (int i = 0; i < msg.signalCount; ++i) decodeSlot(i);
+        return;
+    }
+
+    // Multiplexed: the always-present signals (the multiplexor among them), then the selected group
+    for (int idx : msg.plainSignals) decodeSlot(idx);
+    const uint64_t selector = raw[msg.firstHandle + msg.muxSignalIndex];
+    if (selector < msg.muxGroups.size()) {
+        for (int idx : msg.muxGroups[static_cast<size_t>(selector)]) decodeSlot(idx);
+    }
+}
+
+} // namespace ccs
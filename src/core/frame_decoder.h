@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/can_frame.h"
+#include "core/dbc_layout.h"
+#include "core/signal_table.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ccs {
+
+/// Decoded signal values indexed by signal handle
+struct SignalValues {
+    std::vector<uint64_t> raw;
+    std::vector<double> physical;
+    std::vector<uint8_t> valid; // 0 if the raw value is the signal's SNA value
+
+    void resize(size_t count)
+    {
+        raw.resize(count);
+        physical.resize(count);
+        valid.resize(count);
+    }
+};
+
+/// Receive path of one CAN channel in standard C++. It finds the frame's message in a
+/// DbcLayout and skips a payload that repeats the previous frame with that ID. Other
+/// payloads are decoded into values(). Every known frame updates table().
+///
+/// process() takes no lock and does not allocate; one thread calls it. table(),
+/// decodedCount() and repeatedCount() may be read from any thread.
+class FrameDecoder {
+public:
+    enum class Outcome : uint8_t {
+        Unknown,  // ID not in the layout
+        Decoded,  // values() holds the signals the frame carried
+        Repeated  // same payload as the previous frame with this ID; nothing was decoded
+    };
+
+    struct Result {
+        Outcome outcome = Outcome::Unknown;
+        const MessageLayout* message = nullptr;
+        int messageIndex = -1; // position of message in layout().messages()
+    };
+
+    FrameDecoder() = default;
+    FrameDecoder(const FrameDecoder&) = delete;
+    FrameDecoder& operator=(const FrameDecoder&) = delete;
+
+    /// Decode with layout from now on, forgetting earlier payloads and table values.
+    /// Must not overlap process() or table readers.
+    void setLayout(DbcLayout layout);
+    const DbcLayout& layout() const { return m_layout; }
+
+    Result process(const CanFrame& frame);
+
+    /// Latest decoded values. A message's slots change only when process() decodes it.
+    const SignalValues& values() const { return m_values; }
+    const SignalTable& table() const { return m_table; }
+
+    /// Frames of known messages that were decoded, and that were skipped as repeats
+    uint64_t decodedCount() const { return m_decodedCount.load(std::memory_order_relaxed); }
+    uint64_t repeatedCount() const { return m_repeatedCount.load(std::memory_order_relaxed); }
+
+private:
+    /// Last payload per message, by position in the layout
+    struct Payload {
+        uint64_t data = 0;
+        uint8_t dlc = 0;
+        bool seen = false;
+    };
+
+    void decode(const MessageLayout& msg, const uint8_t* data);
+
+    DbcLayout m_layout;
+    SignalValues m_values;
+    SignalTable m_table;
+    std::vector<Payload> m_lastPayload;
+    std::atomic<uint64_t> m_decodedCount{0};
+    std::atomic<uint64_t> m_repeatedCount{0};
+};
+
+} // namespace ccs
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ccs {
+
+/// Bounded multi-producer, single-consumer FIFO of a trivially copyable T.
+/// push() is lock-free from any number of threads: it claims a cell with one CAS
+/// and returns false while the queue is full. pop() never blocks; concurrent pop()
+/// calls must be serialised by the caller. Elements come out in the order their
+/// push() claimed a cell.
+///
+/// Every cell carries a sequence number (D. Vyukov's bounded queue), so the consumer
+/// stops at a cell that is claimed but not yet written instead of reading it.
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "MpscQueue requires a trivially copyable type");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    bool push(const T& value)
+    {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & Mask];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // the consumer has not freed this cell yet
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed); // another producer took it
+            }
+        }
+    }
+
+    /// False when empty, or when the oldest element's producer is still writing it
+    bool pop(T& value)
+    {
+        Cell& cell = m_cells[m_head & Mask];
+        if (cell.sequence.load(std::memory_order_acquire) != m_head + 1) return false;
+        value = cell.value;
+        cell.sequence.store(m_head + Capacity, std::memory_order_release);
+        ++m_head;
+        return true;
+    }
+
+private:
+    static constexpr size_t Mask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    // Producers and the consumer each keep their index on their own cache line
+    alignas(64) std::atomic<size_t> m_tail{0};
+    alignas(64) size_t m_head = 0;
+    std::array<Cell, Capacity> m_cells;
+};
+
+} // namespace ccs
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ccs {
+
+/// Single-writer sequence lock holding a copy of a trivially copyable T.
+/// store() never blocks or waits for readers. load() is lock-free: it retries only
+/// while a store is in progress and always returns a value written by one store.
+/// Concurrent store() calls must be serialised by the caller.
+///
+/// The payload is kept in relaxed atomic words rather than a plain T, so a read that
+/// overlaps a write is a retried read, not a data race.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() { store(T{}); }
+    explicit SeqLock(const T& value) { store(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    void store(const T& value)
+    {
+        std::array<uint64_t, Words> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const uint32_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < Words; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    T load() const
+    {
+        std::array<uint64_t, Words> words;
+        uint32_t before, after;
+        do {
+            before = m_sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < Words; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = m_sequence.load(std::memory_order_relaxed);
+        } while ((before & 1u) != 0 || before != after);
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t Words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> m_sequence{0};
+    std::array<std::atomic<uint64_t>, Words> m_words{};
+};
+
+} // namespace ccs
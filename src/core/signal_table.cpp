@@ -0,0 +1,120 @@
+#include "core/signal_table.h"
+#include <bit>
+
+namespace ccs {
+
+namespace {
+
+/// Signals a frame of msg carries when its multiplexor reads selector
+template <typename F>
+void forEachPresent(const MessageLayout& msg, uint64_t selector, F&& f)
+{
+    if (msg.muxSignalIndex < 0) {
+        for (int i = 0; i < msg.signalCount; ++i) f(i);
+        return;
+    }
+    for (int idx : msg.plainSignals) f(idx);
+    if (selector < msg.muxGroups.size()) {
+        for (int idx : msg.muxGroups[static_cast<size_t>(selector)]) f(idx);
+    }
+}
+
+int64_t toNanoseconds(SignalTable::Clock::time_point timestamp)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+} // namespace
+
+void SignalTable::resize(const DbcLayout& layout)
+{
+    m_size = layout.signalCount();
+    m_entries = std::make_unique<Entry[]>(m_size);
+    m_sequence.store(0, std::memory_order_release);
+}
+
+void SignalTable::write(Entry& entry, uint64_t raw, uint64_t physicalBits, uint8_t valid,
+                        int64_t timestampNs, uint64_t sequence)
+{
+    const uint32_t lock = entry.lock.load(std::memory_order_relaxed);
+    entry.lock.store(lock + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.raw.store(raw, std::memory_order_relaxed);
+    entry.physicalBits.store(physicalBits, std::memory_order_relaxed);
+    entry.valid.store(valid, std::memory_order_relaxed);
+    entry.timestampNs.store(timestampNs, std::memory_order_relaxed);
+    entry.sequence.store(sequence, std::memory_order_relaxed);
+    entry.lock.store(lock + 2, std::memory_order_release);
+}
+
+void SignalTable::update(const MessageLayout& msg, const uint64_t* raw, const double* physical,
+                         const uint8_t* valid, Clock::time_point timestamp)
+{
+    if (!covers(msg)) return;
+
+    const uint64_t sequence = m_sequence.load(std::memory_order_relaxed) + 1;
+    const int64_t ns = toNanoseconds(timestamp);
+    const uint64_t selector = msg.muxSignalIndex >= 0 ? raw[msg.firstHandle + msg.muxSignalIndex] : 0;
+    forEachPresent(msg, selector, [&](int index) {
+        const int handle = msg.firstHandle + index;
+        write(m_entries[handle], raw[handle], std::bit_cast<uint64_t>(physical[handle]), valid[handle], ns, sequence);
+    });
+    m_sequence.store(sequence, std::memory_order_release);
+}
+
+void SignalTable::touch(const MessageLayout& msg, Clock::time_point timestamp)
+{
+    if (!covers(msg)) return;
+
+    // Same payload, same multiplexor value: the signals the last frame carried.
+    // Their values stand; only the timestamp and sequence move.
+    const uint64_t sequence = m_sequence.load(std::memory_order_relaxed) + 1;
+    const int64_t ns = toNanoseconds(timestamp);
+    const uint64_t selector = msg.muxSignalIndex >= 0
+        ? m_entries[msg.firstHandle + msg.muxSignalIndex].raw.load(std::memory_order_relaxed) : 0;
+    forEachPresent(msg, selector, [&](int index) {
+        Entry& entry = m_entries[msg.firstHandle + index];
+        const uint32_t lock = entry.lock.load(std::memory_order_relaxed);
+        entry.lock.store(lock + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.timestampNs.store(ns, std::memory_order_relaxed);
+        entry.sequence.store(sequence, std::memory_order_relaxed);
+        entry.lock.store(lock + 2, std::memory_order_release);
+    });
+    m_sequence.store(sequence, std::memory_order_release);
+}
+
+SignalTable::Value SignalTable::value(int handle) const
+{
+    if (handle < 0 || handle >= m_size) return {};
+
+    const Entry& entry = m_entries[handle];
+    Value value;
+    uint32_t before, after;
+    int64_t ns;
+    uint64_t physicalBits;
+    do {
+        before = entry.lock.load(std::memory_order_acquire);
+        value.raw = entry.raw.load(std::memory_order_relaxed);
+        physicalBits = entry.physicalBits.load(std::memory_order_relaxed);
+        value.valid = entry.valid.load(std::memory_order_relaxed) != 0;
+        ns = entry.timestampNs.load(std::memory_order_relaxed);
+        value.sequence = entry.sequence.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = entry.lock.load(std::memory_order_relaxed);
+    } while ((before & 1u) != 0 || before != after);
+
+    value.physical = std::bit_cast<double>(physicalBits);
+    value.timestamp = Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns)));
+    return value;
+}
+
+SignalTable::Clock::duration SignalTable::age(int handle, Clock::time_point now) const
+{
+    if (handle < 0 || handle >= m_size) return Clock::duration::max();
+    const int64_t ns = m_entries[handle].timestampNs.load(std::memory_order_relaxed);
+    if (ns == 0) return Clock::duration::max(); // never received
+    return now - Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+} // namespace ccs
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "core/dbc_layout.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace ccs {
+
+/// Latest received value of every signal in a DBC, indexed by signal handle.
+///
+/// One writer (the module thread) stores each received frame's signals through
+/// update(), or touch() when the payload repeats the previous frame. Every frame
+/// gets the next table-wide sequence number; each signal keeps the number and
+/// receive time of the frame that last carried it. value() reads one signal from
+/// any thread in O(1): lock-free, and never a mix of two updates. age() compares
+/// that receive time with now, so staleness needs no timer per signal.
+class SignalTable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Value {
+        uint64_t raw = 0;
+        double physical = 0.0;
+        bool valid = false;     // false if SNA, or never received
+        uint64_t sequence = 0;  // frame that last carried the signal, 0 = never received
+        Clock::time_point timestamp; // receive time of that frame
+    };
+
+    SignalTable() = default;
+    SignalTable(const SignalTable&) = delete;
+    SignalTable& operator=(const SignalTable&) = delete;
+
+    /// One unset entry per signal handle of layout. Must not overlap readers.
+    void resize(const DbcLayout& layout);
+    int size() const { return m_size; }
+
+    /// Store the signals a frame of msg carried, from handle-indexed decode results.
+    /// For a multiplexed message that is the plain signals and the active group.
+    void update(const MessageLayout& msg, const uint64_t* raw, const double* physical, const uint8_t* valid,
+                Clock::time_point timestamp);
+    /// A frame of msg with the same payload as the last: values stand, their
+    /// sequence and timestamp advance
+    void touch(const MessageLayout& msg, Clock::time_point timestamp);
+
+    /// Latest value of a signal; unset Value for an unknown handle
+    Value value(int handle) const;
+    /// Time since a frame last carried the signal, Clock::duration::max() if none has.
+    /// One atomic load, no locking.
+    Clock::duration age(int handle, Clock::time_point now = Clock::now()) const;
+    bool isFresh(int handle, Clock::duration maxAge, Clock::time_point now = Clock::now()) const
+    {
+        return age(handle, now) <= maxAge;
+    }
+    /// Sequence number of the latest frame, i.e. frames stored since resize()
+    uint64_t sequence() const { return m_sequence.load(std::memory_order_acquire); }
+
+private:
+    /// Per-signal seqlock: lock is odd while the writer updates the entry
+    struct Entry {
+        std::atomic<uint32_t> lock{0};
+        std::atomic<uint8_t> valid{0};
+        std::atomic<uint64_t> raw{0};
+        std::atomic<uint64_t> physicalBits{0};
+        std::atomic<int64_t> timestampNs{0};
+        std::atomic<uint64_t> sequence{0};
+    };
+
+    bool covers(const MessageLayout& msg) const
+    {
+        return msg.firstHandle >= 0 && msg.firstHandle + msg.signalCount <= m_size;
+    }
+    static void write(Entry& entry, uint64_t raw, uint64_t physicalBits, uint8_t valid,
+                      int64_t timestampNs, uint64_t sequence);
+
+    std::unique_ptr<Entry[]> m_entries;
+    int m_size = 0;
+    std::atomic<uint64_t> m_sequence{0};
+};
+
+} // namespace ccs
@@ -0,0 +1,108 @@
+#include "core/timer_wheel.h"
+
+namespace ccs {
+
+void TimerWheel::reset(int timerCount, uint64_t nowMs)
+{
+    m_nodes.assign(static_cast<size_t>(std::max(timerCount, 0)), Node{});
+    for (auto& level : m_heads) level.fill(-1);
+    m_occupied.fill(0);
+    m_next = nowMs;
+    m_armed = 0;
+}
+
+void TimerWheel::arm(int timer, uint64_t deadlineMs)
+{
+    Node& node = m_nodes[static_cast<size_t>(timer)];
+    if (node.level >= 0) {
+        unlink(timer);
+    } else {
+        ++m_armed;
+    }
+    node.deadline = deadlineMs;
+    file(timer);
+}
+
+void TimerWheel::cancel(int timer)
+{
+    if (!isArmed(timer)) return;
+    unlink(timer);
+    --m_armed;
+}
+
+uint64_t TimerWheel::nextExpiry() const
+{
+    if (m_armed == 0) return Never;
+
+    uint64_t earliest = Never;
+    for (int level = 0; level < Levels; ++level) {
+        if (m_occupied[level] == 0) continue;
+        // The level's slots are processed on its own grid of 64^level ticks:
+        // find the first grid point from m_next on, then the first occupied slot from there
+        const int shift = SlotBits * level;
+        const uint64_t base = (m_next + (uint64_t{1} << shift) - 1) >> shift;
+        const int offset = std::countr_zero(std::rotr(m_occupied[level], static_cast<int>(base & SlotMask)));
+        earliest = std::min(earliest, (base + static_cast<uint64_t>(offset)) << shift);
+    }
+    return earliest;
+}
+
+void TimerWheel::file(int timer)
+{
+    Node& node = m_nodes[static_cast<size_t>(timer)];
+    uint64_t when = std::max(node.deadline, m_next);
+    if (when - m_next >= Horizon) {
+        when = m_next + Horizon - 1; // parked; filed again with its real deadline on the way down
+    }
+
+    // Level L holds the timers due in [64^L, 64^(L+1)) ticks
+    const uint64_t delta = when - m_next;
+    const int level = delta == 0 ? 0 : (static_cast<int>(std::bit_width(delta)) - 1) / SlotBits;
+    const auto slot = static_cast<uint8_t>((when >> (SlotBits * level)) & SlotMask);
+
+    int& head = m_heads[level][slot];
+    node.level = static_cast<int8_t>(level);
+    node.slot = slot;
+    node.prev = -1;
+    node.next = head;
+    if (head >= 0) m_nodes[static_cast<size_t>(head)].prev = timer;
+    head = timer;
+    m_occupied[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::unlink(int timer)
+{
+    Node& node = m_nodes[static_cast<size_t>(timer)];
+    if (node.prev >= 0) {
+        m_nodes[static_cast<size_t>(node.prev)].next = node.next;
+    } else {
+        int& head = m_heads[node.level][node.slot];
+        head = node.next;
+        if (head < 0) m_occupied[node.level] &= ~(uint64_t{1} << node.slot);
+    }
+    if (node.next >= 0) m_nodes[static_cast<size_t>(node.next)].prev = node.prev;
+    node.prev = node.next = -1;
+    node.level = -1;
+}
+
+void TimerWheel::cascade(uint64_t tick)
+{
+    // tick is a multiple of 64: file the level-1 slot it starts down a level,
+    // and the higher levels' slots too where tick also starts one of those
+    for (int level = 1; level < Levels; ++level) {
+        const int shift = SlotBits * level;
+        if ((tick & ((uint64_t{1} << shift) - 1)) != 0) return;
+
+        const auto slot = static_cast<size_t>((tick >> shift) & SlotMask);
+        int timer = m_heads[level][slot];
+        m_heads[level][slot] = -1;
+        m_occupied[level] &= ~(uint64_t{1} << slot);
+        while (timer >= 0) {
+            const int next = m_nodes[static_cast<size_t>(timer)].next;
+            file(timer); // m_next == tick, so it lands on a lower level
+            timer = next;
+        }
+    }
+}
+
+} // namespace ccs
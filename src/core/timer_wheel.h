@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ccs {
+
+/// Hierarchical timing wheel with 1 ms ticks. It has four levels of 64 slots, so it
+/// covers 2^24 ms (about 4.6 h) ahead. A later deadline waits in the top level and is
+/// filed again as time approaches. A slot is filed down a level when time reaches it.
+///
+/// Timers are numbered 0..size()-1. arm(), cancel() and a re-arm are O(1) and do not
+/// allocate. advance() costs one step per 64 ms that pass plus one per timer it files
+/// or fires. A timer never fires before its deadline, and fires on the tick of its
+/// deadline if advance() is called then. One thread uses a wheel at a time.
+class TimerWheel {
+public:
+    static constexpr uint64_t Never = std::numeric_limits<uint64_t>::max();
+
+    /// timerCount timers, none armed; time starts at nowMs
+    void reset(int timerCount, uint64_t nowMs);
+    int size() const { return static_cast<int>(m_nodes.size()); }
+    bool empty() const { return m_armed == 0; }
+
+    /// (Re)arm timer to fire at deadlineMs. A deadline advance() has already passed
+    /// fires on the tick after the last one it processed.
+    void arm(int timer, uint64_t deadlineMs);
+    void cancel(int timer);
+    bool isArmed(int timer) const { return m_nodes[static_cast<size_t>(timer)].level >= 0; }
+    uint64_t deadline(int timer) const { return m_nodes[static_cast<size_t>(timer)].deadline; }
+
+    /// Earliest time advance() has work to do, Never if no timer is armed.
+    /// Sleeping until then never misses a deadline.
+    uint64_t nextExpiry() const;
+
+    /// Bring the wheel to nowMs, calling expired(timer) for every timer whose deadline
+    /// has come, earliest first. A timer is disarmed before its callback, which may arm it again.
+    template <typename F>
+    void advance(uint64_t nowMs, F&& expired);
+
+private:
+    static constexpr int SlotBits = 6;
+    static constexpr int Slots = 1 << SlotBits;
+    static constexpr uint64_t SlotMask = Slots - 1;
+    static constexpr int Levels = 4;
+    static constexpr uint64_t Horizon = uint64_t{1} << (SlotBits * Levels);
+
+    struct Node {
+        uint64_t deadline = 0;
+        int prev = -1;
+        int next = -1;
+        int8_t level = -1; // -1: not armed
+        uint8_t slot = 0;
+    };
+
+    void file(int timer);
+    void unlink(int timer);
+    void cascade(uint64_t tick);
+
+    std::vector<Node> m_nodes;
+    std::array<std::array<int, Slots>, Levels> m_heads{};
+    std::array<uint64_t, Levels> m_occupied{}; // bit n: slot n of the level has timers
+    uint64_t m_next = 0;                       // first tick not yet processed
+    int m_armed = 0;
+};
+
+template <typename F>
+void TimerWheel::advance(uint64_t nowMs, F&& expired)
+{
+    while (m_next <= nowMs) {
+        if (m_armed == 0) {
+            m_next = nowMs + 1;
+            return;
+        }
+        const uint64_t tick = m_next;
+        if ((tick & SlotMask) == 0) cascade(tick);
+
+        // Skip straight to the next occupied level-0 slot of this rotation, or its end
+        const uint64_t ahead = m_occupied[0] >> (tick & SlotMask);
+        if (ahead == 0) {
+            m_next = std::min((tick | SlotMask) + 1, nowMs + 1);
+            continue;
+        }
+        const uint64_t due = tick + static_cast<uint64_t>(std::countr_zero(ahead));
+        if (due > nowMs) {
+            m_next = nowMs + 1;
+            return;
+        }
+
+        m_next = due + 1; // a timer armed from a callback lands after this tick
+        int& head = m_heads[0][due & SlotMask];
+        while (head >= 0) {
+            const int timer = head;
+            unlink(timer);
+            if (m_nodes[static_cast<size_t>(timer)].deadline > due) {
+                file(timer); // parked beyond the horizon: not due yet
+                continue;
+            }
+            --m_armed;
+            expired(timer);
+        }
+    }
+}
+
+} // namespace ccs
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace ccs {
+
+/// Cycle counter for stamping pipeline stages: the TSC on x86, the virtual
+/// counter on AArch64, steady_clock nanoseconds elsewhere. Reading it costs a
+/// few nanoseconds and no system call. Ticks are only compared with ticks; use
+/// toNanoseconds() when reporting.
+class TscClock {
+public:
+    static uint64_t now() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /// Tick rate, measured against steady_clock from program start to the first
+    /// call (at least 20 ms), so it needs no calibration loop at startup
+    static double ticksPerNanosecond()
+    {
+        static const double rate = [] {
+            if (std::chrono::steady_clock::now() - origin().wall < std::chrono::milliseconds(20)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            const Sample end = sample();
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end.wall - origin().wall).count();
+            return static_cast<double>(end.ticks - origin().ticks) / static_cast<double>(ns);
+        }();
+        return rate;
+    }
+
+    static double toNanoseconds(uint64_t ticks) { return static_cast<double>(ticks) / ticksPerNanosecond(); }
+
+private:
+    struct Sample {
+        uint64_t ticks;
+        std::chrono::steady_clock::time_point wall;
+    };
+
+    static Sample sample() { return {now(), std::chrono::steady_clock::now()}; }
+
+    static const Sample& origin()
+    {
+        static const Sample start = sample();
+        return start;
+    }
+
+    // Take the first sample during static initialisation
+    static inline const Sample& s_origin = origin();
+};
+
+} // namespace ccs
@@ -0,0 +1,400 @@
+#include "daemon/charger_daemon.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSettings>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QDebug>
+
+namespace ccs {
+
+ChargerDaemon::ChargerDaemon(QObject* parent)
+    : QObject(parent)
+{
+    // Same threading as the GUI: the protocol core runs on its own thread
+    m_moduleThread = new QThread(this);
+    m_moduleThread->setObjectName("ChargeModule");
+    m_module = new ChargeModule;
+    m_module->moveToThread(m_moduleThread);
+    m_moduleThread->start();
+
+    m_pcanDriver = new PcanDriver(this);
+    m_simInterface = new SimulatedCanInterface(this);
+    m_logger = new CanLogger(this);
+    m_sessionReport = new SessionReport(this);
+
+    connect(m_module, &ChargeModule::stateChanged, this, &ChargerDaemon::onStateChanged);
+    connect(m_module, &ChargeModule::errorCodeReceived, this, [](uint16_t code, const QString& desc) {
+        qWarning().noquote() << QString("Module error 0x%1: %2").arg(code, 4, 16, QChar('0')).arg(desc);
+    });
+    connect(m_module, &ChargeModule::rawFrameReceived, m_logger, &CanLogger::logFrame);
+    connect(m_module, &ChargeModule::rawFrameReceived, this, [this]() { m_rxFrameCount++; });
+    connect(m_module, &ChargeModule::rawFrameSent, this, [this]() { m_txFrameCount++; });
+    connect(m_module, &ChargeModule::evseDataChanged, this, [this](ChargeModule::EvseFieldMask changed) {
+        constexpr auto presentValues = ChargeModule::fieldBit(ChargeModule::EvseField::EvsePresentVoltage)
+                                     | ChargeModule::fieldBit(ChargeModule::EvseField::EvsePresentCurrent);
+        if (changed & presentValues) {
+            onSampleTimer();
+        }
+    });
+
+    connect(m_module->safetyMonitor(), &SafetyMonitor::emergencyStopTriggered, this, [this](const QString& reason) {
+        qWarning() << "Daemon: emergency stop -" << reason;
+        endSession();
+    });
+
+    connect(m_module->safetyMonitor(), &SafetyMonitor::heartbeatLost, this, [this]() { m_heartbeatOk = false; });
+    connect(m_module->safetyMonitor(), &SafetyMonitor::heartbeatRestored, this, [this]() { m_heartbeatOk = true; });
+
+    // evseDataChanged() is silent while values hold steady; keep the session energy continuous
+    m_sampleTimer = new QTimer(this);
+    connect(m_sampleTimer, &QTimer::timeout, this, &ChargerDaemon::onSampleTimer);
+}
+
+ChargerDaemon::~ChargerDaemon()
+{
+    stop();
+    // The module's timers belong to its thread: delete it there, then stop the thread
+    QMetaObject::invokeMethod(m_module, [this] { delete m_module; }, Qt::BlockingQueuedConnection);
+    m_module = nullptr;
+    m_moduleThread->quit();
+    m_moduleThread->wait();
+}
+
+bool ChargerDaemon::loadConfig(const QString& path)
+{
+    if (!QFile::exists(path)) {
+        m_lastError = "Config file not found: " + path;
+        return false;
+    }
+
+    QSettings settings(path, QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError) {
+        m_lastError = "Cannot read config file: " + path;
+        return false;
+    }
+
+    // Relative paths in the file are relative to the file itself
+    const QDir base(QFileInfo(path).absolutePath());
+    Config config;
+
+    const QString interface = settings.value("can/interface", "simulation").toString().toLower();
+    if (interface != "simulation" && interface != "pcan") {
+        m_lastError = "can/interface must be 'simulation' or 'pcan', not '" + interface + "'";
+        return false;
+    }
+    config.simulation = interface == "simulation";
+
+    bool ok = false;
+    const QString channel = settings.value("can/channel", config.simulation ? "0x0001" : "0x0051").toString();
+    config.channel = static_cast<uint16_t>(channel.toUInt(&ok, 0)); // accepts 0x51 and 81
+    if (!ok) {
+        m_lastError = "Invalid can/channel: " + channel;
+        return false;
+    }
+    config.baudRate = settings.value("can/baudrate", config.baudRate).toUInt();
+
+    const QString dbc = settings.value("dbc/path", "ISC_CMS_Automotive.dbc").toString();
+    config.dbcPath = base.filePath(dbc);
+
+    const QString logDir = settings.value("logging/directory").toString();
+    config.logDirectory = logDir.isEmpty() ? QString() : base.filePath(logDir);
+    config.rawLog = settings.value("logging/raw", config.rawLog).toBool();
+    config.decodedLog = settings.value("logging/decoded", config.decodedLog).toBool();
+    config.saveReport = settings.value("logging/report", config.saveReport).toBool();
+
+    config.socketName = settings.value("control/socket", config.socketName).toString();
+    config.autoStart = settings.value("session/autostart", config.autoStart).toBool();
+
+    config.evMaxVoltage = settings.value("ev/max_voltage", config.evMaxVoltage).toDouble();
+    config.evMaxCurrent = settings.value("ev/max_current", config.evMaxCurrent).toDouble();
+    config.evMaxPower = settings.value("ev/max_power", config.evMaxPower).toDouble();
+    config.evSoC = settings.value("ev/soc", config.evSoC).toDouble();
+    config.evFullSoC = settings.value("ev/full_soc", config.evFullSoC).toDouble();
+    config.evBulkSoC = settings.value("ev/bulk_soc", config.evBulkSoC).toDouble();
+    config.evEnergyCapacity = settings.value("ev/energy_capacity", config.evEnergyCapacity).toDouble();
+    config.evEnergyRequest = settings.value("ev/energy_request", config.evEnergyRequest).toDouble();
+    config.evPreChargeVoltage = settings.value("ev/precharge_voltage", config.evPreChargeVoltage).toDouble();
+    config.evTargetVoltage = settings.value("ev/target_voltage", config.evTargetVoltage).toDouble();
+    config.evTargetCurrent = settings.value("ev/target_current", config.evTargetCurrent).toDouble();
+
+    m_config = config;
+    return true;
+}
+
+bool ChargerDaemon::start()
+{
+    // A daemon that answers on the control socket is still running: refuse before
+    // touching the CAN hardware, and never take its socket away
+    {
+        QLocalSocket probe;
+        probe.connectToServer(m_config.socketName);
+        if (probe.waitForConnected(SocketProbeTimeoutMs)) {
+            probe.disconnectFromServer();
+            m_lastError = "Another daemon is already listening on control socket " + m_config.socketName;
+            return false;
+        }
+    }
+
+    if (!QFile::exists(m_config.dbcPath)) {
+        m_lastError = "DBC file not found: " + m_config.dbcPath;
+        return false;
+    }
+    m_module->loadDbc(m_config.dbcPath);
+    m_logger->setCodec(&m_module->codec());
+    for (const auto& warning : m_module->bindingWarnings()) {
+        qWarning() << "DBC binding:" << warning;
+    }
+
+    if (m_config.simulation) {
+        m_canInterface = m_simInterface;
+    } else {
+        if (!m_pcanDriver->isLibraryLoaded() && !m_pcanDriver->loadLibrary()) {
+            m_lastError = "Failed to load PCAN-Basic library: " + m_pcanDriver->lastError();
+            return false;
+        }
+        m_canInterface = m_pcanDriver;
+    }
+    if (!m_canInterface->open(m_config.channel, m_config.baudRate)) {
+        m_lastError = "Failed to open CAN interface: " + m_canInterface->lastError();
+        m_canInterface = nullptr;
+        return false;
+    }
+
+    // Nothing answered the probe above, so a socket file left here is stale (a previous
+    // daemon crashed) and listen() would fail on it
+    QLocalServer::removeServer(m_config.socketName);
+    m_server = new QLocalServer(this);
+    if (!m_server->listen(m_config.socketName)) {
+        m_lastError = "Cannot listen on control socket " + m_config.socketName + ": " + m_server->errorString();
+        m_canInterface->close();
+        m_canInterface = nullptr;
+        return false;
+    }
+    connect(m_server, &QLocalServer::newConnection, this, &ChargerDaemon::onNewConnection);
+
+    if (!m_config.logDirectory.isEmpty()) {
+        QDir().mkpath(m_config.logDirectory);
+        if (m_config.rawLog && !m_logger->startRawLog(logFilePath("_raw.csv"))) {
+            qWarning() << "Daemon: cannot write raw log in" << m_config.logDirectory;
+        }
+        if (m_config.decodedLog && !m_logger->startDecodedLog(logFilePath("_decoded.csv"))) {
+            qWarning() << "Daemon: cannot write decoded log in" << m_config.logDirectory;
+        }
+    }
+
+    m_module->setCanInterface(m_canInterface);
+    m_module->start();
+    applyEvParameters();
+    m_sampleTimer->start(250);
+
+    qDebug() << "Daemon: running on" << (m_config.simulation ? "simulation" : "PCAN")
+             << "channel" << m_config.channel << "- control socket" << m_server->fullServerName();
+
+    if (m_config.autoStart) {
+        startSession();
+    }
+    return true;
+}
+
+void ChargerDaemon::stop()
+{
+    if (!m_canInterface) return;
+
+    endSession();
+    m_sampleTimer->stop();
+    if (m_module->isRunning()) {
+        m_module->stop();
+    }
+    m_canInterface->close();
+    m_canInterface = nullptr;
+    m_logger->stopAll();
+
+    if (m_server) {
+        m_server->close();
+    }
+    qDebug() << "Daemon: stopped";
+}
+
+// ─── Session ─────────────────────────────────────────────
+
+void ChargerDaemon::applyEvParameters()
+{
+    m_module->setEvMaxVoltage(m_config.evMaxVoltage);
+    m_module->setEvMaxCurrent(m_config.evMaxCurrent);
+    m_module->setEvMaxPower(m_config.evMaxPower);
+    m_module->setEvSoC(m_config.evSoC);
+    m_module->setEvErrorCode(0); // NO_ERROR
+    m_module->setEvFullSoC(m_config.evFullSoC);
+    m_module->setEvBulkSoC(m_config.evBulkSoC);
+    m_module->setEvEnergyCapacity(m_config.evEnergyCapacity);
+    m_module->setEvEnergyRequest(m_config.evEnergyRequest);
+    m_module->setEvPreChargeVoltage(m_config.evPreChargeVoltage);
+    m_module->setEvTargetVoltage(m_config.evTargetVoltage);
+    m_module->setEvTargetCurrent(m_config.evTargetCurrent);
+}
+
+void ChargerDaemon::startSession()
+{
+    m_module->requestStartCharging();
+    m_sessionReport->startSession();
+    qDebug() << "Daemon: charging requested";
+}
+
+void ChargerDaemon::endSession()
+{
+    if (!m_sessionReport->isActive()) return;
+
+    m_sessionReport->endSession();
+    qDebug().noquote() << QString("Daemon: session ended after %1 s, %2 Wh")
+        .arg(m_sessionReport->durationSeconds())
+        .arg(m_sessionReport->energyEstimateWh(), 0, 'f', 0);
+
+    if (m_config.saveReport && !m_config.logDirectory.isEmpty()) {
+        const QString path = logFilePath("_session_report.txt");
+        if (!m_sessionReport->saveReport(path)) {
+            qWarning() << "Daemon: cannot write session report" << path;
+        }
+    }
+}
+
+void ChargerDaemon::onStateChanged(CmsState state)
+{
+    qDebug() << "Daemon: state" << cmsStateToString(state);
+
+    // PreCharge and the handoff to Charge are handled by the module's sequencer
+    if (state == CmsState::ShutOff) {
+        endSession();
+    }
+}
+
+void ChargerDaemon::onSampleTimer()
+{
+    if (!m_sessionReport->isActive()) return;
+
+    const auto evse = m_module->evseSnapshot();
+    const bool fresh = m_module->isFresh(ChargeModule::EvseField::EvsePresentVoltage)
+                    && m_module->isFresh(ChargeModule::EvseField::EvsePresentCurrent);
+    m_sessionReport->updateValues(evse.evsePresentVoltage, evse.evsePresentCurrent,
+                                  m_module->evParamsSnapshot().evSoC, fresh);
+}
+
+QString ChargerDaemon::logFilePath(const QString& suffix) const
+{
+    return QDir(m_config.logDirectory).filePath(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + suffix);
+}
+
+// ─── Control socket ──────────────────────────────────────
+
+void ChargerDaemon::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+            while (socket->canReadLine()) {
+                const QString line = QString::fromUtf8(socket->readLine()).trimmed();
+                if (line.isEmpty()) continue;
+                socket->write((execute(line) + "\n").toUtf8());
+            }
+            socket->flush();
+        });
+    }
+}
+
+QString ChargerDaemon::execute(const QString& command)
+{
+    const QStringList args = command.split(' ', Qt::SkipEmptyParts);
+    if (args.isEmpty()) return "ERR empty command";
+    const QString verb = args.front().toLower();
+
+    if (verb == "status") {
+        return "OK " + statusLine();
+    }
+    if (verb == "shutdown") {
+        emit shutdownRequested();
+        return "OK shutting down";
+    }
+    if (verb == "report") {
+        if (args.size() != 2) return "ERR usage: report <path>";
+        return m_sessionReport->saveReport(args[1]) ? "OK" : "ERR cannot write " + args[1];
+    }
+    if (verb == "latency") {
+        LatencyTrace* trace = m_module->latencyTrace();
+        if (args.size() == 1) {
+            // Reply stays one line: stages separated by "; "
+            return "OK " + trace->summary().trimmed().replace('\n', "; ");
+        }
+        if (args.size() != 2) return "ERR usage: latency [<directory>]";
+        QString error;
+        return trace->exportHistograms(args[1], &error) ? "OK" : "ERR " + error;
+    }
+
+    if (!m_module->isRunning()) {
+        return "ERR module not running";
+    }
+    if (verb == "start") {
+        startSession();
+        return "OK";
+    }
+    if (verb == "stop") {
+        m_module->requestStopCharging();
+        endSession();
+        return "OK";
+    }
+    if (verb == "estop") {
+        m_module->emergencyStop();
+        endSession();
+        return "OK";
+    }
+    if (verb == "reset") {
+        m_module->resetModule();
+        return "OK";
+    }
+    if (verb == "set") {
+        bool ok = false;
+        const double value = args.size() == 3 ? args[2].toDouble(&ok) : 0.0;
+        if (!ok) return "ERR usage: set <parameter> <value>";
+        return setParameter(args[1].toLower(), value) ? "OK" : "ERR unknown parameter " + args[1];
+    }
+    return "ERR unknown command " + verb;
+}
+
+bool ChargerDaemon::setParameter(const QString& name, double value)
+{
+    if (name == "target_voltage") m_module->setEvTargetVoltage(value);
+    else if (name == "target_current") m_module->setEvTargetCurrent(value);
+    else if (name == "precharge_voltage") m_module->setEvPreChargeVoltage(value);
+    else if (name == "max_voltage") m_module->setEvMaxVoltage(value);
+    else if (name == "max_current") m_module->setEvMaxCurrent(value);
+    else if (name == "max_power") m_module->setEvMaxPower(value);
+    else if (name == "soc") m_module->setEvSoC(value);
+    else if (name == "full_soc") m_module->setEvFullSoC(value);
+    else if (name == "bulk_soc") m_module->setEvBulkSoC(value);
+    else if (name == "energy_capacity") m_module->setEvEnergyCapacity(value);
+    else if (name == "energy_request") m_module->setEvEnergyRequest(value);
+    else return false;
+    return true;
+}
+
+QString ChargerDaemon::statusLine() const
+{
+    const auto evse = m_module->evseSnapshot();
+    const auto ev = m_module->evParamsSnapshot();
+    return QString("state=%1 running=%2 heartbeat=%3 voltage=%4 current=%5 soc=%6 rx=%7 tx=%8 session=%9 energy_wh=%10 present_stale=%11")
+        .arg(cmsStateToString(evse.stateMachineState))
+        .arg(m_module->isRunning() ? 1 : 0)
+        .arg(m_heartbeatOk ? 1 : 0)
+        .arg(evse.evsePresentVoltage, 0, 'f', 1)
+        .arg(evse.evsePresentCurrent, 0, 'f', 1)
+        .arg(ev.evSoC, 0, 'f', 1)
+        .arg(m_rxFrameCount)
+        .arg(m_txFrameCount)
+        .arg(m_sessionReport->isActive() ? "active" : "idle")
+        .arg(m_sessionReport->energyEstimateWh(), 0, 'f', 0)
+        .arg(m_module->isFresh(ChargeModule::EvseField::EvsePresentVoltage)
+             && m_module->isFresh(ChargeModule::EvseField::EvsePresentCurrent) ? 0 : 1);
+}
+
+} // namespace ccs
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "module/charge_module.h"
+#include "can/can_interface.h"
+#include "can/pcan_driver.h"
+#include "logging/can_logger.h"
+#include "logging/session_report.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace ccs {
+
+/// Runs one Charge Module without a UI, for rack PCs and vehicle gateways.
+///
+/// The session setup (CAN interface, DBC, EV parameters, logging) comes from an
+/// INI file, see ccs_chargerd.ini.example. While running, the daemon accepts
+/// line-based commands on a local socket (Unix domain socket / named pipe):
+///
+///     status | start | stop | estop | reset | set <parameter> <value> |
+///     report <path> | latency [<directory>] | shutdown
+///
+/// Every command gets one reply line starting with "OK" or "ERR".
+class ChargerDaemon : public QObject {
+    Q_OBJECT
+public:
+    struct Config {
+        bool simulation = true;
+        uint16_t channel = 0x0001;          // PCAN handle, or simulated channel
+        uint32_t baudRate = 500000;         // bit/s
+        QString dbcPath;                    // relative paths are resolved against the config file
+
+        QString logDirectory;               // empty: no logging
+        bool rawLog = true;
+        bool decodedLog = false;
+        bool saveReport = true;             // write a report into logDirectory when a session ends
+
+        QString socketName = "ccs-charger";
+        bool autoStart = false;             // request charging as soon as the module runs
+
+        // EV parameters sent once the module runs (datasheet: CMS needs non-SNA values)
+        double evMaxVoltage = 500.0;
+        double evMaxCurrent = 200.0;
+        double evMaxPower = 100000.0;
+        double evSoC = 50.0;
+        double evFullSoC = 100.0;
+        double evBulkSoC = 80.0;
+        double evEnergyCapacity = 60000.0;
+        double evEnergyRequest = 40000.0;
+        double evPreChargeVoltage = 400.0;
+        double evTargetVoltage = 400.0;
+        double evTargetCurrent = 0.0;
+    };
+
+    explicit ChargerDaemon(QObject* parent = nullptr);
+    ~ChargerDaemon() override;
+
+    bool loadConfig(const QString& path);
+    const Config& config() const { return m_config; }
+
+    /// Load the DBC, open CAN, start the module and listen for control connections
+    bool start();
+    /// Close the session, send the safe state and close CAN
+    void stop();
+
+    /// Execute one control command and return its reply line (without newline)
+    QString execute(const QString& command);
+
+    QString lastError() const { return m_lastError; }
+
+signals:
+    /// A client sent "shutdown"
+    void shutdownRequested();
+
+private slots:
+    void onStateChanged(ccs::CmsState state);
+    void onNewConnection();
+    void onSampleTimer();
+
+private:
+    /// How long start() waits for a running daemon to answer on the control socket
+    static constexpr int SocketProbeTimeoutMs = 500;
+
+    void applyEvParameters();
+    void startSession();
+    void endSession();
+    bool setParameter(const QString& name, double value);
+    QString statusLine() const;
+    QString logFilePath(const QString& suffix) const;
+
+    Config m_config;
+    QString m_lastError;
+
+    ChargeModule* m_module = nullptr;
+    QThread* m_moduleThread = nullptr;
+    CanInterface* m_canInterface = nullptr; // m_pcanDriver or m_simInterface
+    PcanDriver* m_pcanDriver = nullptr;
+    SimulatedCanInterface* m_simInterface = nullptr;
+
+    CanLogger* m_logger = nullptr;
+    SessionReport* m_sessionReport = nullptr;
+    QTimer* m_sampleTimer = nullptr;
+    QLocalServer* m_server = nullptr;
+
+    uint64_t m_rxFrameCount = 0;
+    uint64_t m_txFrameCount = 0;
+    bool m_heartbeatOk = false;
+};
+
+} // namespace ccs
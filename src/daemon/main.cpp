@@ -0,0 +1,95 @@
+#include "daemon/charger_daemon.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSocketNotifier>
+#include <QDebug>
+
+#ifdef PLATFORM_LINUX
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#elif defined(PLATFORM_WINDOWS)
+#include <windows.h>
+#endif
+
+namespace {
+
+#ifdef PLATFORM_LINUX
+// SIGINT/SIGTERM only write to this pipe; the event loop does the shutdown
+int g_signalFds[2] = {-1, -1};
+
+void onTerminationSignal(int)
+{
+    const char byte = 1;
+    [[maybe_unused]] const auto written = ::write(g_signalFds[0], &byte, 1);
+}
+
+void installTerminationHandler()
+{
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, g_signalFds) != 0) {
+        qWarning() << "Daemon: no signal pipe, SIGTERM will not stop the session cleanly";
+        return;
+    }
+    auto* notifier = new QSocketNotifier(g_signalFds[1], QSocketNotifier::Read, QCoreApplication::instance());
+    QObject::connect(notifier, &QSocketNotifier::activated, notifier, [notifier]() {
+        notifier->setEnabled(false);
+        char byte;
+        [[maybe_unused]] const auto read = ::read(g_signalFds[1], &byte, 1);
+        QCoreApplication::quit();
+    });
+
+    struct sigaction action = {};
+    action.sa_handler = onTerminationSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+#elif defined(PLATFORM_WINDOWS)
+BOOL WINAPI onConsoleControl(DWORD)
+{
+    // Runs on a system thread
+    QMetaObject::invokeMethod(QCoreApplication::instance(), &QCoreApplication::quit, Qt::QueuedConnection);
+    return TRUE;
+}
+
+void installTerminationHandler()
+{
+    SetConsoleCtrlHandler(onConsoleControl, TRUE);
+}
+#endif
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("CCS Charger Daemon");
+    app.setApplicationVersion("1.0.0");
+    app.setOrganizationName("CCS Charger Project");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs a Charge Module S session without a UI, controlled over a local socket.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("config", "Session config file (INI), see ccs_chargerd.ini.example.");
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    ccs::ChargerDaemon daemon;
+    if (!daemon.loadConfig(args.front()) || !daemon.start()) {
+        qCritical().noquote() << daemon.lastError();
+        return 1;
+    }
+
+    installTerminationHandler();
+    QObject::connect(&daemon, &ccs::ChargerDaemon::shutdownRequested, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+
+    const int result = app.exec();
+    daemon.stop(); // safe state and logs closed before the module thread goes away
+    return result;
+}
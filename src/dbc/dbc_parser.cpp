@@ -2,10 +2,50 @@
 #include <QFile>
 #include <QTextStream>
 #include <QRegularExpression>
+#include <QHash>
+#include <QThread>
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
 
 namespace ccs {
 
+DbcLayout DbcDatabase::layout() const
+{
+    // Message order is canId order, as in DbcParser::assignSignalHandles(), so the
+    // layout numbers the signals the same way
+    DbcLayout result;
+    for (const auto& msg : messages) {
+        MessageLayout message;
+        message.canId = msg.canId;
+        message.extended = msg.extended;
+        message.dlc = msg.dlc;
+        message.cycleTimeMs = msg.cycleTimeMs;
+        message.name = msg.name.toStdString();
+        message.muxSignalIndex = msg.muxSignalIndex;
+        message.plainSignals.assign(msg.plainSignals.cbegin(), msg.plainSignals.cend());
+        for (const auto& group : msg.muxGroups) {
+            message.muxGroups.emplace_back(group.cbegin(), group.cend());
+        }
+        result.addMessage(std::move(message));
+
+        for (const auto& sig : msg.dbcSignals) {
+            SignalLayout signal;
+            signal.startBit = sig.startBit;
+            signal.bitLength = sig.bitLength;
+            signal.factor = sig.factor;
+            signal.offset = sig.offset;
+            signal.littleEndian = sig.littleEndian;
+            signal.isSigned = sig.isSigned;
+            // addSignal() derives the plan and SNA raw value the same way validateLayout()
+            // and buildValueTables() do
+            const auto sna = sig.hasSna ? std::optional<int64_t>(static_cast<int64_t>(sig.snaRaw)) : std::nullopt;
+            result.addSignal(signal, sig.name.toStdString(), sna);
+        }
+    }
+    return result;
+}
+
 bool DbcParser::parse(const QString& filePath)
 {
     QFile file(filePath);
@@ -15,62 +55,400 @@ bool DbcParser::parse(const QString& filePath)
     }
 
     QTextStream stream(&file);
-    m_currentMessage = nullptr;
+    return parseText(stream.readAll());
+}
+
+bool DbcParser::parseText(const QString& text)
+{
+    QStringList lines = text.split('\n');
+    const int lineCount = static_cast<int>(lines.size());
+
+    int chunkCount = 1;
+    if (lineCount >= ParallelThreshold) {
+        int maxThreads = (m_maxThreads > 0) ? m_maxThreads : QThread::idealThreadCount();
+        chunkCount = std::clamp(lineCount / MinLinesPerChunk, 1, std::max(1, maxThreads));
+    }
+
+    // Phase 1: split into line ranges. A range may only start on a blank line or a
+    // BO_ line, so every SG_ stays with the message it belongs to.
+    QVector<int> bounds;
+    bounds.append(0);
+    for (int i = 1; i < chunkCount; ++i) {
+        int b = std::max(bounds.last(), lineCount * i / chunkCount);
+        while (b < lineCount) {
+            QString line = lines[b].trimmed();
+            if (line.isEmpty() || line.startsWith("BO_ ")) break;
+            ++b;
+        }
+        bounds.append(b);
+    }
+    bounds.append(lineCount);
+
+    QVector<Chunk> chunks(chunkCount);
+    QVector<QThread*> workers;
+    for (int i = 1; i < chunkCount; ++i) {
+        QThread* worker = QThread::create([&lines, &bounds, &chunks, i]() {
+            parseChunk(lines, bounds[i], bounds[i + 1], chunks[i]);
+        });
+        worker->start();
+        workers.append(worker);
+    }
+    parseChunk(lines, bounds[0], bounds[1], chunks[0]);
+    for (QThread* worker : workers) {
+        worker->wait();
+        delete worker;
+    }
 
-    // Read all lines and process
-    QString fullText = stream.readAll();
-    QStringList lines = fullText.split('\n');
+    // Phase 2: single-threaded merge and cross-reference resolution
+    mergeChunks(chunks);
+    m_warnings.clear();
+    buildMultiplexTables();
+    validateLayout();
+    assignSignalHandles();
+    buildValueTables();
+    return true;
+}
 
-    for (int i = 0; i < lines.size(); ++i) {
+void DbcParser::parseChunk(const QStringList& lines, int begin, int end, Chunk& out)
+{
+    int currentMessage = -1;
+    for (int i = begin; i < end; ++i) {
         QString line = lines[i].trimmed();
         if (line.isEmpty()) {
-            m_currentMessage = nullptr;
+            currentMessage = -1;
             continue;
         }
-        parseLine(line);
+        parseLine(line, out, currentMessage);
     }
+}
 
-    return true;
+void DbcParser::mergeChunks(QVector<Chunk>& chunks)
+{
+    for (auto& chunk : chunks) {
+        for (auto& msg : chunk.messages) {
+            uint32_t canId = msg.canId;
+            m_db.messages[canId] = std::move(msg);
+        }
+    }
+
+    // Index every message and signal once, so each reference below is a hash
+    // lookup instead of contains() + operator[] + a linear signal scan.
+    struct MessageIndex {
+        DbcMessage* msg = nullptr;
+        QHash<QString, DbcSignal*> signalsByName;
+    };
+    QHash<uint32_t, MessageIndex> index;
+    index.reserve(m_db.messages.size());
+    for (auto it = m_db.messages.begin(); it != m_db.messages.end(); ++it) {
+        MessageIndex& entry = index[it.key()];
+        entry.msg = &it.value();
+        for (auto& sig : it.value().dbcSignals) {
+            if (!entry.signalsByName.contains(sig.name)) {
+                entry.signalsByName.insert(sig.name, &sig);
+            }
+        }
+    }
+
+    auto findMessage = [&index](uint32_t canId) -> DbcMessage* {
+        auto it = index.find(canId);
+        return (it != index.end()) ? it->msg : nullptr;
+    };
+    auto findSignal = [&index](uint32_t canId, const QString& name) -> DbcSignal* {
+        auto it = index.find(canId);
+        if (it == index.end()) return nullptr;
+        return it->signalsByName.value(name, nullptr);
+    };
+
+    using Kind = PendingRef::Kind;
+    for (const auto& chunk : chunks) {
+        for (const auto& ref : chunk.refs) {
+            switch (ref.kind) {
+                case Kind::NodeList:
+                    m_db.nodes = ref.nodes;
+                    break;
+                case Kind::DbName:
+                    m_db.name = ref.text;
+                    break;
+                case Kind::BusType:
+                    m_db.busType = ref.text;
+                    break;
+                case Kind::MessageComment:
+                    if (auto* msg = findMessage(ref.canId)) msg->comment = ref.text;
+                    break;
+                case Kind::CycleTime:
+                    if (auto* msg = findMessage(ref.canId)) msg->cycleTimeMs = ref.value;
+                    break;
+                case Kind::StartDelayTime:
+                    if (auto* msg = findMessage(ref.canId)) msg->startDelayMs = ref.value;
+                    break;
+                case Kind::SendType:
+                    if (auto* msg = findMessage(ref.canId)) msg->sendType = ref.text;
+                    break;
+                case Kind::SignalComment:
+                    if (auto* sig = findSignal(ref.canId, ref.signalName)) sig->comment = ref.text;
+                    break;
+                case Kind::StartValue:
+                    if (auto* sig = findSignal(ref.canId, ref.signalName)) sig->startValue = ref.value;
+                    break;
+                case Kind::ValueDescriptions:
+                    if (auto* sig = findSignal(ref.canId, ref.signalName)) {
+                        for (auto it = ref.values.begin(); it != ref.values.end(); ++it) {
+                            sig->valueDescriptions[it.key()] = it.value();
+                        }
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+bool DbcParser::signalBitMask(const DbcSignal& sig, uint32_t payloadBits, uint64_t& mask)
+{
+    return DbcLayout::signalBitMask(sig.startBit, sig.bitLength, sig.littleEndian, payloadBits, mask);
+}
+
+void DbcParser::compileExtractionPlan(DbcSignal& sig)
+{
+    DbcLayout::compileExtractionPlan(sig.startBit, sig.bitLength, sig.littleEndian, sig.planShift, sig.planMask);
+}
+
+void DbcParser::compileFixedPoint(DbcSignal& sig)
+{
+    sig.fixedPointExact = false;
+    if (sig.factor == 0.0 || sig.bitLength == 0 || sig.bitLength > 63) return;
+
+    // Factors and offsets come from decimal literals, so an exact scale shows up as an
+    // integer within the rounding error of the literal's double conversion
+    auto isIntegral = [](double v, double rounded) {
+        return std::abs(v - rounded) <= 1e-9 * std::max(1.0, std::abs(rounded));
+    };
+    const double int64Limit = std::ldexp(1.0, 62);
+
+    double scale = 1.0;
+    for (int decimals = 0; decimals <= MaxFixedDecimals; ++decimals, scale *= 10.0) {
+        double factor = std::round(sig.factor * scale);
+        double offset = std::round(sig.offset * scale);
+        if (factor == 0.0 || !isIntegral(sig.factor * scale, factor) || !isIntegral(sig.offset * scale, offset)) {
+            continue;
+        }
+
+        // |raw × factor + offset| must stay inside int64 for every raw value
+        if (std::ldexp(std::abs(factor), static_cast<int>(sig.bitLength)) + std::abs(offset) >= int64Limit) {
+            return;
+        }
+
+        sig.fixedDecimals = static_cast<uint8_t>(decimals);
+        sig.fixedFactor = static_cast<int64_t>(factor);
+        sig.fixedOffset = static_cast<int64_t>(offset);
+        sig.fixedMinimum = static_cast<int64_t>(std::round(std::clamp(sig.minimum * scale, -int64Limit, int64Limit)));
+        sig.fixedMaximum = static_cast<int64_t>(std::round(std::clamp(sig.maximum * scale, -int64Limit, int64Limit)));
+        sig.fixedPointExact = true;
+        return;
+    }
+}
+
+void DbcParser::buildMultiplexTables()
+{
+    for (auto it = m_db.messages.begin(); it != m_db.messages.end(); ++it) {
+        DbcMessage& msg = it.value();
+        msg.muxSignalIndex = -1;
+        msg.plainSignals.clear();
+        msg.muxGroups.clear();
+
+        for (int i = 0; i < msg.dbcSignals.size(); ++i) {
+            if (msg.dbcSignals[i].isMultiplexor && msg.muxSignalIndex < 0) {
+                msg.muxSignalIndex = i;
+            }
+        }
+
+        for (int i = 0; i < msg.dbcSignals.size(); ++i) {
+            DbcSignal& sig = msg.dbcSignals[i];
+            if (sig.muxValue < 0) {
+                msg.plainSignals.append(i);
+                continue;
+            }
+            if (msg.muxSignalIndex < 0 || sig.muxValue > MaxMuxSelector) {
+                m_warnings.append(QString("%1 (0x%2): multiplexed signal %3 (m%4) has no usable multiplexor")
+                    .arg(msg.name).arg(msg.canId, 0, 16).arg(sig.name).arg(sig.muxValue));
+                continue;
+            }
+            if (msg.muxGroups.size() <= sig.muxValue) {
+                msg.muxGroups.resize(sig.muxValue + 1);
+            }
+            msg.muxGroups[sig.muxValue].append(i);
+        }
+    }
+}
+
+void DbcParser::assignSignalHandles()
+{
+    // Handles follow message (canId) order, so each message's signals are contiguous
+    m_db.signalRefs.clear();
+    for (auto it = m_db.messages.begin(); it != m_db.messages.end(); ++it) {
+        DbcMessage& msg = it.value();
+        msg.firstHandle = static_cast<int>(m_db.signalRefs.size());
+        for (int i = 0; i < msg.dbcSignals.size(); ++i) {
+            m_db.signalRefs.append({msg.canId, i});
+        }
+    }
+}
+
+void DbcParser::buildValueTables()
+{
+    m_db.stringTable.clear();
+    QHash<QString, int> stringIndex;
+
+    for (auto it = m_db.messages.begin(); it != m_db.messages.end(); ++it) {
+        for (auto& sig : it.value().dbcSignals) {
+            sig.valueTextDense.clear();
+            sig.valueTextSparse.clear();
+            sig.hasSna = false;
+            sig.snaRaw = 0;
+            if (sig.valueDescriptions.isEmpty()) continue;
+
+            uint64_t maxRaw = 0;
+            for (auto v = sig.valueDescriptions.cbegin(); v != sig.valueDescriptions.cend(); ++v) {
+                uint64_t raw = DbcLayout::valueTableRaw(static_cast<int64_t>(v.key()), sig.bitLength);
+                auto found = stringIndex.constFind(v.value());
+                int index = (found != stringIndex.constEnd()) ? found.value() : -1;
+                if (index < 0) {
+                    index = static_cast<int>(m_db.stringTable.size());
+                    m_db.stringTable.append(v.value());
+                    stringIndex.insert(v.value(), index);
+                }
+                sig.valueTextSparse.append({raw, index});
+                maxRaw = std::max(maxRaw, raw);
+                if (v.value() == "SNA" && !sig.hasSna) {
+                    sig.hasSna = true;
+                    sig.snaRaw = raw;
+                }
+            }
+
+            std::sort(sig.valueTextSparse.begin(), sig.valueTextSparse.end());
+            if (maxRaw < MaxDenseValueTable) {
+                sig.valueTextDense.fill(-1, static_cast<int>(maxRaw) + 1);
+                for (const auto& entry : sig.valueTextSparse) {
+                    sig.valueTextDense[static_cast<int>(entry.first)] = entry.second;
+                }
+                sig.valueTextSparse.clear();
+            }
+        }
+    }
+}
+
+void DbcParser::validateLayout()
+{
+    for (auto it = m_db.messages.begin(); it != m_db.messages.end(); ++it) {
+        DbcMessage& msg = it.value();
+        const uint32_t payloadBits = std::min<uint32_t>(msg.dlc, 8) * 8;
+
+        QVector<uint64_t> masks(msg.dbcSignals.size(), 0);
+        QVector<bool> inBounds(msg.dbcSignals.size(), false);
+        for (int i = 0; i < msg.dbcSignals.size(); ++i) {
+            const DbcSignal& sig = msg.dbcSignals[i];
+            inBounds[i] = signalBitMask(sig, payloadBits, masks[i]);
+            if (!inBounds[i]) {
+                m_warnings.append(QString("%1 (0x%2): signal %3 (%4|%5@%6) exceeds the %7-byte payload")
+                    .arg(msg.name).arg(msg.canId, 0, 16).arg(sig.name)
+                    .arg(sig.startBit).arg(sig.bitLength).arg(sig.littleEndian ? 1 : 0)
+                    .arg(msg.dlc));
+            }
+        }
+
+        // Bits claimed twice within one set of co-present signals end up in 'shared'
+        auto accumulate = [&](const QVector<int>& indices, uint64_t& occupied, uint64_t& shared) {
+            for (int i : indices) {
+                if (!inBounds[i]) continue;
+                shared |= occupied & masks[i];
+                occupied |= masks[i];
+            }
+        };
+
+        // Plain signals are always present; each mux group only shares the frame with
+        // them, so signals of different groups may legitimately reuse the same bits.
+        uint64_t plainOccupied = 0;
+        uint64_t shared = 0;
+        accumulate(msg.plainSignals, plainOccupied, shared);
+        uint64_t occupied = plainOccupied;
+        for (const auto& group : msg.muxGroups) {
+            uint64_t groupOccupied = plainOccupied;
+            accumulate(group, groupOccupied, shared);
+            occupied |= groupOccupied;
+        }
+        msg.occupiedBits = occupied;
+
+        // Mark safe signals and report every signal touching a shared bit
+        for (int i = 0; i < msg.dbcSignals.size(); ++i) {
+            DbcSignal& sig = msg.dbcSignals[i];
+            sig.layoutValid = inBounds[i] && (masks[i] & shared) == 0;
+            if (sig.layoutValid) {
+                compileExtractionPlan(sig);
+            }
+            if (inBounds[i] && !sig.layoutValid) {
+                m_warnings.append(QString("%1 (0x%2): signal %3 overlaps another signal")
+                    .arg(msg.name).arg(msg.canId, 0, 16).arg(sig.name));
+            }
+
+            double rawA = (sig.factor != 0.0) ? (sig.minimum - sig.offset) / sig.factor : 0.0;
+            double rawB = (sig.factor != 0.0) ? (sig.maximum - sig.offset) / sig.factor : 0.0;
+            double rawMin = std::round(std::min(rawA, rawB));
+            double rawMax = std::round(std::max(rawA, rawB));
+            // Raw values are integral, so 'rawMax < 2^n' is 'rawMax <= 2^n - 1' without double rounding at n = 64
+            int valueBits = static_cast<int>(sig.bitLength) - (sig.isSigned ? 1 : 0);
+            double lo = sig.isSigned ? -std::ldexp(1.0, valueBits) : 0.0;
+            double limit = std::ldexp(1.0, valueBits);
+            sig.rawRangeFits = sig.layoutValid && sig.factor != 0.0 && rawMin >= lo && rawMax < limit;
+
+            compileFixedPoint(sig);
+        }
+    }
+
+    for (const auto& warning : m_warnings) {
+        qWarning() << "DBC layout:" << warning;
+    }
 }
 
-void DbcParser::parseLine(const QString& line)
+void DbcParser::parseLine(const QString& line, Chunk& chunk, int& currentMessage)
 {
     if (line.startsWith("BU_:")) {
-        parseNodeList(line);
+        parseNodeList(line, chunk);
     }
     else if (line.startsWith("BO_ ")) {
-        parseMessage(line);
+        parseMessage(line, chunk, currentMessage);
     }
     else if (line.startsWith(" SG_ ") || line.startsWith("SG_ ")) {
-        if (m_currentMessage) {
-            parseSignal(line, *m_currentMessage);
+        if (currentMessage >= 0) {
+            parseSignal(line, chunk.messages[currentMessage]);
         }
     }
     else if (line.startsWith("CM_ ")) {
-        parseComment(line);
+        parseComment(line, chunk);
     }
     else if (line.startsWith("BA_DEF_DEF_ ")) {
         parseAttributeDefault(line);
     }
     else if (line.startsWith("BA_ ")) {
-        parseAttribute(line);
+        parseAttribute(line, chunk);
     }
     else if (line.startsWith("VAL_ ")) {
-        parseValueDescription(line);
+        parseValueDescription(line, chunk);
     }
     else if (line.startsWith("BA_DEF_ ") && line.contains("\"DBName\"")) {
         // Skip definitions
     }
 }
 
-void DbcParser::parseNodeList(const QString& line)
+void DbcParser::parseNodeList(const QString& line, Chunk& chunk)
 {
     // BU_: VCU CMS
-    QString rest = line.mid(4).trimmed();
-    m_db.nodes = rest.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    static const QRegularExpression rxSpace("\\s+");
+    PendingRef ref;
+    ref.kind = PendingRef::Kind::NodeList;
+    ref.nodes = line.mid(4).trimmed().split(rxSpace, Qt::SkipEmptyParts);
+    chunk.refs.append(std::move(ref));
 }
 
-void DbcParser::parseMessage(const QString& line)
+void DbcParser::parseMessage(const QString& line, Chunk& chunk, int& currentMessage)
 {
     // BO_ 2147488512 EVDCMaxLimits: 8 VCU
     static QRegularExpression rx(R"(BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+))");
@@ -92,35 +470,44 @@ void DbcParser::parseMessage(const QString& line)
         msg.canId = msg.id;
     }
 
-    m_db.messages[msg.canId] = msg;
-    m_currentMessage = &m_db.messages[msg.canId];
+    chunk.messages.append(std::move(msg));
+    currentMessage = static_cast<int>(chunk.messages.size()) - 1;
 }
 
 void DbcParser::parseSignal(const QString& line, DbcMessage& msg)
 {
     // SG_ EVMaxCurrent : 0|16@1+ (0.1,0) [0|6500] "A" CMS
+    // SG_ DiagSelector M : 0|8@1+ (1,0) [0|255] "" CMS       (multiplexor)
+    // SG_ DiagValue m3 : 8|16@1+ (1,0) [0|65535] "" CMS      (present when DiagSelector == 3)
     static QRegularExpression rx(
-        R"(SG_\s+(\w+)\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*\(([^,]+),([^)]+)\)\s*\[([^|]+)\|([^\]]+)\]\s*\"([^\"]*)\"\s*(.*))");
+        R"(SG_\s+(\w+)(?:\s+(M|m\d+M?))?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*\(([^,]+),([^)]+)\)\s*\[([^|]+)\|([^\]]+)\]\s*\"([^\"]*)\"\s*(.*))");
 
     auto match = rx.match(line.trimmed());
     if (!match.hasMatch()) return;
 
     DbcSignal sig;
     sig.name = match.captured(1);
-    sig.startBit = match.captured(2).toUInt();
-    sig.bitLength = match.captured(3).toUInt();
-    sig.littleEndian = (match.captured(4) == "1");
-    sig.isSigned = (match.captured(5) == "-");
-    sig.factor = match.captured(6).toDouble();
-    sig.offset = match.captured(7).toDouble();
-    sig.minimum = match.captured(8).toDouble();
-    sig.maximum = match.captured(9).toDouble();
-    sig.unit = match.captured(10);
+    QString mux = match.captured(2);
+    if (mux == "M") {
+        sig.isMultiplexor = true;
+    } else if (mux.startsWith('m')) {
+        // "m3M" (extended multiplexing) is treated as a signal of group 3
+        sig.muxValue = mux.mid(1, mux.endsWith('M') ? mux.size() - 2 : -1).toInt();
+    }
+    sig.startBit = match.captured(3).toUInt();
+    sig.bitLength = match.captured(4).toUInt();
+    sig.littleEndian = (match.captured(5) == "1");
+    sig.isSigned = (match.captured(6) == "-");
+    sig.factor = match.captured(7).toDouble();
+    sig.offset = match.captured(8).toDouble();
+    sig.minimum = match.captured(9).toDouble();
+    sig.maximum = match.captured(10).toDouble();
+    sig.unit = match.captured(11);
 
     msg.dbcSignals.append(sig);
 }
 
-void DbcParser::parseComment(const QString& line)
+void DbcParser::parseComment(const QString& line, Chunk& chunk)
 {
     // CM_ BO_ 2147488512 "description";
     // CM_ SG_ 2147488512 EVMaxCurrent "description";
@@ -129,28 +516,22 @@ void DbcParser::parseComment(const QString& line)
 
     auto matchBo = rxBo.match(line);
     if (matchBo.hasMatch()) {
-        uint32_t rawId = matchBo.captured(1).toUInt();
-        uint32_t canId = rawId & 0x1FFFFFFF;
-        if (m_db.messages.contains(canId)) {
-            m_db.messages[canId].comment = matchBo.captured(2);
-        }
+        PendingRef ref;
+        ref.kind = PendingRef::Kind::MessageComment;
+        ref.canId = matchBo.captured(1).toUInt() & 0x1FFFFFFF;
+        ref.text = matchBo.captured(2);
+        chunk.refs.append(std::move(ref));
         return;
     }
 
     auto matchSg = rxSg.match(line);
     if (matchSg.hasMatch()) {
-        uint32_t rawId = matchSg.captured(1).toUInt();
-        uint32_t canId = rawId & 0x1FFFFFFF;
-        QString sigName = matchSg.captured(2);
-        if (m_db.messages.contains(canId)) {
-            auto& msg = m_db.messages[canId];
-            for (auto& sig : msg.dbcSignals) {
-                if (sig.name == sigName) {
-                    sig.comment = matchSg.captured(3);
-                    break;
-                }
-            }
-        }
+        PendingRef ref;
+        ref.kind = PendingRef::Kind::SignalComment;
+        ref.canId = matchSg.captured(1).toUInt() & 0x1FFFFFFF;
+        ref.signalName = matchSg.captured(2);
+        ref.text = matchSg.captured(3);
+        chunk.refs.append(std::move(ref));
     }
 }
 
@@ -160,90 +541,83 @@ void DbcParser::parseAttributeDefault(const QString& /*line*/)
     // We store defaults but use them only when specific BA_ values aren't set
 }
 
-void DbcParser::parseAttribute(const QString& line)
+void DbcParser::parseAttribute(const QString& line, Chunk& chunk)
 {
     // BA_ "GenMsgCycleTime" BO_ 2147488512 100;
     static QRegularExpression rxCycle(R"(BA_\s+\"GenMsgCycleTime\"\s+BO_\s+(\d+)\s+(\d+)\s*;)");
+    static QRegularExpression rxStartDelay(R"(BA_\s+\"GenMsgStartDelayTime\"\s+BO_\s+(\d+)\s+(\d+)\s*;)");
     static QRegularExpression rxSendType(R"(BA_\s+\"GenMsgSendType\"\s+BO_\s+(\d+)\s+(\d+)\s*;)");
     static QRegularExpression rxStartValue(R"(BA_\s+\"GenSigStartValue\"\s+SG_\s+(\d+)\s+(\w+)\s+(\d+)\s*;)");
     static QRegularExpression rxDbName(R"(BA_\s+\"DBName\"\s+\"([^\"]*)\"\s*;)");
     static QRegularExpression rxBusType(R"(BA_\s+\"BusType\"\s+\"([^\"]*)\"\s*;)");
 
+    PendingRef ref;
+
     auto matchDb = rxDbName.match(line);
     if (matchDb.hasMatch()) {
-        m_db.name = matchDb.captured(1);
+        ref.kind = PendingRef::Kind::DbName;
+        ref.text = matchDb.captured(1);
+        chunk.refs.append(std::move(ref));
         return;
     }
 
     auto matchBus = rxBusType.match(line);
     if (matchBus.hasMatch()) {
-        m_db.busType = matchBus.captured(1);
+        ref.kind = PendingRef::Kind::BusType;
+        ref.text = matchBus.captured(1);
+        chunk.refs.append(std::move(ref));
         return;
     }
 
     auto matchCycle = rxCycle.match(line);
     if (matchCycle.hasMatch()) {
-        uint32_t rawId = matchCycle.captured(1).toUInt();
-        uint32_t canId = rawId & 0x1FFFFFFF;
-        int cycle = matchCycle.captured(2).toInt();
-        if (m_db.messages.contains(canId)) {
-            m_db.messages[canId].cycleTimeMs = cycle;
-        }
+        ref.kind = PendingRef::Kind::CycleTime;
+        ref.canId = matchCycle.captured(1).toUInt() & 0x1FFFFFFF;
+        ref.value = matchCycle.captured(2).toInt();
+        chunk.refs.append(std::move(ref));
+        return;
+    }
+
+    auto matchDelay = rxStartDelay.match(line);
+    if (matchDelay.hasMatch()) {
+        ref.kind = PendingRef::Kind::StartDelayTime;
+        ref.canId = matchDelay.captured(1).toUInt() & 0x1FFFFFFF;
+        ref.value = matchDelay.captured(2).toInt();
+        chunk.refs.append(std::move(ref));
         return;
     }
 
     auto matchSend = rxSendType.match(line);
     if (matchSend.hasMatch()) {
-        uint32_t rawId = matchSend.captured(1).toUInt();
-        uint32_t canId = rawId & 0x1FFFFFFF;
-        int type = matchSend.captured(2).toInt();
-        if (m_db.messages.contains(canId)) {
-            static const char* types[] = {"Cyclic", "Event-driven", "On request", "dummy"};
-            m_db.messages[canId].sendType = types[std::min(type, 3)];
-        }
+        static const char* types[] = {"Cyclic", "Event-driven", "On request", "dummy"};
+        ref.kind = PendingRef::Kind::SendType;
+        ref.canId = matchSend.captured(1).toUInt() & 0x1FFFFFFF;
+        ref.text = types[std::min(matchSend.captured(2).toInt(), 3)];
+        chunk.refs.append(std::move(ref));
         return;
     }
 
     auto matchStart = rxStartValue.match(line);
     if (matchStart.hasMatch()) {
-        uint32_t rawId = matchStart.captured(1).toUInt();
-        uint32_t canId = rawId & 0x1FFFFFFF;
-        QString sigName = matchStart.captured(2);
-        int val = matchStart.captured(3).toInt();
-        if (m_db.messages.contains(canId)) {
-            auto& msg = m_db.messages[canId];
-            for (auto& sig : msg.dbcSignals) {
-                if (sig.name == sigName) {
-                    sig.startValue = val;
-                    break;
-                }
-            }
-        }
+        ref.kind = PendingRef::Kind::StartValue;
+        ref.canId = matchStart.captured(1).toUInt() & 0x1FFFFFFF;
+        ref.signalName = matchStart.captured(2);
+        ref.value = matchStart.captured(3).toInt();
+        chunk.refs.append(std::move(ref));
     }
 }
 
-void DbcParser::parseValueDescription(const QString& line)
+void DbcParser::parseValueDescription(const QString& line, Chunk& chunk)
 {
     // VAL_ 2147487744 StateMachineState 15 "SNA" 0 "Default" 1 "Init" ...;
     static QRegularExpression rxHeader(R"(VAL_\s+(\d+)\s+(\w+)\s+)");
     auto matchHeader = rxHeader.match(line);
     if (!matchHeader.hasMatch()) return;
 
-    uint32_t rawId = matchHeader.captured(1).toUInt();
-    uint32_t canId = rawId & 0x1FFFFFFF;
-    QString sigName = matchHeader.captured(2);
-
-    if (!m_db.messages.contains(canId)) return;
-    auto& msg = m_db.messages[canId];
-
-    DbcSignal* targetSig = nullptr;
-    for (auto& sig : msg.dbcSignals) {
-        if (sig.name == sigName) {
-            targetSig = &sig;
-            break;
-        }
-    }
-    if (!targetSig) return;
+    PendingRef ref;
+    ref.kind = PendingRef::Kind::ValueDescriptions;
+    ref.canId = matchHeader.captured(1).toUInt() & 0x1FFFFFFF;
+    ref.signalName = matchHeader.captured(2);
 
     // Parse value-description pairs: number "string"
     QString remainder = line.mid(matchHeader.capturedEnd());
@@ -251,8 +625,9 @@ void DbcParser::parseValueDescription(const QString& line)
     auto it = rxPair.globalMatch(remainder);
     while (it.hasNext()) {
         auto m = it.next();
-        targetSig->valueDescriptions[m.captured(1).toInt()] = m.captured(2);
+        ref.values[m.captured(1).toInt()] = m.captured(2);
     }
+    chunk.refs.append(std::move(ref));
 }
 
 } // namespace ccs
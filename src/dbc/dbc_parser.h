@@ -1,8 +1,12 @@
 #pragma once
 
+#include "core/dbc_layout.h"
 #include <QString>
+#include <QStringList>
 #include <QMap>
+#include <QPair>
 #include <QVector>
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 
@@ -22,6 +26,34 @@ struct DbcSignal {
     QString comment;
     QMap<int, QString> valueDescriptions; // enumeration values
     int startValue = 0; // GenSigStartValue (often SNA indicator)
+    bool isMultiplexor = false; // "M": selects which multiplexed group is present
+    int muxValue = -1;          // "mNN": only present when the multiplexor equals NN
+
+    // Set by DbcParser's layout validation after parsing
+    bool layoutValid = false;  // all bits inside the payload, no overlap with other signals
+    bool rawRangeFits = false; // [minimum, maximum] encodes without exceeding bitLength
+
+    // Extraction plan (valid when layoutValid): load the 8 payload bytes as one
+    // 64-bit word (byte-swapped for Motorola), then raw = (word >> planShift) & planMask
+    uint8_t planShift = 0;
+    uint64_t planMask = 0;
+
+    // Decimal fixed-point form of the scaling, set at load time when factor and offset
+    // are exact decimals: physical × 10^fixedDecimals = raw × fixedFactor + fixedOffset
+    bool fixedPointExact = false;
+    uint8_t fixedDecimals = 0;
+    int64_t fixedFactor = 0;
+    int64_t fixedOffset = 0;
+    int64_t fixedMinimum = 0; // minimum/maximum in the same scaled units
+    int64_t fixedMaximum = 0;
+
+    // Value-table lookup compiled at load time. Keys are raw bit patterns (negative
+    // VAL_ entries of signed signals are masked to bitLength); values index
+    // DbcDatabase::stringTable.
+    QVector<int> valueTextDense;                    // raw → string index, -1 if none
+    QVector<QPair<uint64_t, int>> valueTextSparse;  // sorted by raw, for spread-out keys
+    bool hasSna = false;  // the value table has an "SNA" entry...
+    uint64_t snaRaw = 0;  // ...for this raw value
 };
 
 struct DbcMessage {
@@ -33,8 +65,24 @@ struct DbcMessage {
     QString transmitter;
     QString comment;
     int cycleTimeMs = 0;     // GenMsgCycleTime
+    int startDelayMs = 0;    // GenMsgStartDelayTime (phase of the first send)
     QString sendType;        // Cyclic, Event-driven, etc.
     QVector<DbcSignal> dbcSignals;
+    uint64_t occupiedBits = 0; // Bit-occupancy bitmap, bit n = payload bit n (byte * 8 + bit)
+
+    // Multiplexing tables, built once after parsing
+    int muxSignalIndex = -1;          // index of the multiplexor signal, -1 if not multiplexed
+    QVector<int> plainSignals;        // signals present in every frame (includes the multiplexor)
+    QVector<QVector<int>> muxGroups;  // selector value → signals present for that value
+
+    // Signal handles: dbcSignals[i] has the database-wide handle firstHandle + i
+    int firstHandle = -1;
+};
+
+/// Reverse mapping from a signal handle to the signal it names
+struct SignalRef {
+    uint32_t canId = 0; // owning message
+    int index = -1;     // position in DbcMessage::dbcSignals
 };
 
 struct DbcDatabase {
@@ -42,6 +90,11 @@ struct DbcDatabase {
     QString busType;
     QVector<QString> nodes;
     QMap<uint32_t, DbcMessage> messages; // key = canId
+    QVector<SignalRef> signalRefs;       // handle → signal, assigned after parsing
+    QVector<QString> stringTable;        // deduplicated value-table texts
+
+    /// Number of signal handles (size needed for handle-indexed buffers)
+    int signalCount() const { return static_cast<int>(signalRefs.size()); }
 
     const DbcMessage* findMessage(uint32_t canId) const {
         auto it = messages.find(canId);
@@ -56,6 +109,46 @@ struct DbcDatabase {
         }
         return nullptr;
     }
+
+    const DbcSignal* signalByHandle(int handle) const {
+        if (handle < 0 || handle >= signalRefs.size()) return nullptr;
+        const auto* msg = findMessage(signalRefs[handle].canId);
+        return msg ? &msg->dbcSignals[signalRefs[handle].index] : nullptr;
+    }
+
+    const DbcMessage* messageByHandle(int handle) const {
+        if (handle < 0 || handle >= signalRefs.size()) return nullptr;
+        return findMessage(signalRefs[handle].canId);
+    }
+
+    /// String-table index of a signal's value-table text for a raw value, -1 if none
+    static int valueTextIndex(const DbcSignal& sig, uint64_t raw) {
+        if (raw < static_cast<uint64_t>(sig.valueTextDense.size())) {
+            return sig.valueTextDense[static_cast<int>(raw)];
+        }
+        if (sig.valueTextSparse.isEmpty()) return -1;
+        auto it = std::lower_bound(sig.valueTextSparse.cbegin(), sig.valueTextSparse.cend(), raw,
+            [](const QPair<uint64_t, int>& entry, uint64_t key) { return entry.first < key; });
+        return (it != sig.valueTextSparse.cend() && it->first == raw) ? it->second : -1;
+    }
+
+    QString valueText(const DbcSignal& sig, uint64_t raw) const {
+        int index = valueTextIndex(sig, raw);
+        return (index >= 0) ? stringTable[index] : QString();
+    }
+
+    /// Qt-free copy of what decoding needs, for FrameDecoder; same signal handles
+    DbcLayout layout() const;
+
+    /// Handle of a signal, or -1 if the message or signal does not exist
+    int signalHandle(uint32_t canId, const QString& signalName) const {
+        const auto* msg = findMessage(canId);
+        if (!msg) return -1;
+        for (int i = 0; i < msg->dbcSignals.size(); ++i) {
+            if (msg->dbcSignals[i].name == signalName) return msg->firstHandle + i;
+        }
+        return -1;
+    }
 };
 
 class DbcParser {
@@ -65,25 +158,99 @@ public:
     /// Parse a .dbc file and return the database
     bool parse(const QString& filePath);
 
+    /// Parse DBC content that is already in memory.
+    /// Large inputs are split into line chunks that are parsed on all cores;
+    /// cross-references (CM_, BA_, VAL_) are resolved in one merge pass afterwards.
+    bool parseText(const QString& text);
+
+    /// Limit the number of worker threads used by parseText (0 = one per core)
+    void setMaxThreads(int threads) { m_maxThreads = threads; }
+
     /// Get the parsed database
     const DbcDatabase& database() const { return m_db; }
     DbcDatabase& database() { return m_db; }
 
     QString lastError() const { return m_lastError; }
 
+    /// Layout problems found after the last parse (out-of-bounds or overlapping signals)
+    const QStringList& warnings() const { return m_warnings; }
+
+    /// Largest multiplexer selector value accepted for the dense selector table
+    static constexpr int MaxMuxSelector = 4095;
+
+    /// Value tables whose largest raw key is below this are stored densely
+    static constexpr uint64_t MaxDenseValueTable = 256;
+
+    /// Compute the payload bits covered by a signal (bit n = byte * 8 + bit).
+    /// Returns false if any bit falls outside payloadBits.
+    static bool signalBitMask(const DbcSignal& sig, uint32_t payloadBits, uint64_t& mask);
+
+    /// Fill planShift/planMask for a signal whose bits lie within the 8-byte payload
+    static void compileExtractionPlan(DbcSignal& sig);
+
+    /// Most decimal places tried when looking for an exact fixed-point scaling
+    static constexpr int MaxFixedDecimals = 9;
+
+    /// Fill the fixedPoint* fields if factor and offset are exact decimals and
+    /// every raw value of the signal scales without overflowing int64
+    static void compileFixedPoint(DbcSignal& sig);
+
 private:
-    void parseLine(const QString& line);
-    void parseMessage(const QString& line);
-    void parseSignal(const QString& line, DbcMessage& msg);
-    void parseComment(const QString& line);
-    void parseAttributeDefault(const QString& line);
-    void parseAttribute(const QString& line);
-    void parseValueDescription(const QString& line);
-    void parseNodeList(const QString& line);
+    /// A line that refers to a message/signal defined elsewhere in the file.
+    /// Collected during the parallel phase, applied in file order by mergeChunks().
+    struct PendingRef {
+        enum class Kind {
+            NodeList,
+            DbName,
+            BusType,
+            MessageComment,
+            SignalComment,
+            CycleTime,
+            StartDelayTime,
+            SendType,
+            StartValue,
+            ValueDescriptions
+        };
+        Kind kind = Kind::NodeList;
+        uint32_t canId = 0;
+        QString signalName;
+        QString text;
+        int value = 0;
+        QVector<QString> nodes;
+        QMap<int, QString> values;
+    };
+
+    /// Output of parsing one contiguous range of lines
+    struct Chunk {
+        QVector<DbcMessage> messages;
+        QVector<PendingRef> refs;
+    };
+
+    /// Minimum line count before the parser fans out to worker threads
+    static constexpr int ParallelThreshold = 4096;
+    /// Minimum lines per worker; smaller chunks cost more in thread start-up than they save
+    static constexpr int MinLinesPerChunk = 2048;
+
+    static void parseChunk(const QStringList& lines, int begin, int end, Chunk& out);
+    static void parseLine(const QString& line, Chunk& chunk, int& currentMessage);
+    static void parseMessage(const QString& line, Chunk& chunk, int& currentMessage);
+    static void parseSignal(const QString& line, DbcMessage& msg);
+    static void parseComment(const QString& line, Chunk& chunk);
+    static void parseAttributeDefault(const QString& line);
+    static void parseAttribute(const QString& line, Chunk& chunk);
+    static void parseValueDescription(const QString& line, Chunk& chunk);
+    static void parseNodeList(const QString& line, Chunk& chunk);
+
+    void mergeChunks(QVector<Chunk>& chunks);
+    void buildMultiplexTables();
+    void validateLayout();
+    void assignSignalHandles();
+    void buildValueTables();
 
     DbcDatabase m_db;
-    DbcMessage* m_currentMessage = nullptr;
     QString m_lastError;
+    QStringList m_warnings;
+    int m_maxThreads = 0;
 };
 
 } // namespace ccs
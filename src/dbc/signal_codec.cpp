@@ -1,9 +1,182 @@
 #include "dbc/signal_codec.h"
+#include "core/bit_codec.h"
+#include <algorithm>
+#include <bit>
 #include <cmath>
 #include <climits>
+#include <cstring>
+
+// SIMD batch kernels are compiled with per-function target attributes and picked
+// at runtime, so the rest of the build keeps its baseline instruction set.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CCS_BATCH_SIMD 1
+#include <immintrin.h>
+#endif
 
 namespace ccs {
 
+namespace {
+
+inline uint64_t extractRaw(const uint8_t* data, const DbcSignal& sig)
+{
+    return sig.layoutValid
+        ? bits::extractPlanned(data, sig.littleEndian, sig.planShift, sig.planMask)
+        : bits::extract(data, sig.startBit, sig.bitLength, sig.littleEndian);
+}
+
+inline bool isSna(const DbcSignal& sig, uint64_t raw)
+{
+    return sig.hasSna && raw == sig.snaRaw;
+}
+
+// Saturate a raw value to the signal's width. A signed raw value is two's complement
+// in 64 bits, so it is clamped as int64 to the signal's range before its bits are kept.
+inline uint64_t saturateRaw(const DbcSignal& sig, uint64_t raw)
+{
+    if (sig.bitLength >= 64) return raw;
+    const uint64_t maxVal = (1ULL << sig.bitLength) - 1;
+    if (!sig.isSigned || sig.bitLength == 0) return std::min(raw, maxVal);
+    const int64_t maxSigned = static_cast<int64_t>(maxVal >> 1);
+    return static_cast<uint64_t>(std::clamp(static_cast<int64_t>(raw), -maxSigned - 1, maxSigned)) & maxVal;
+}
+
+inline void decodeSlot(const uint8_t* data, const DbcSignal& sig, int handle,
+                       uint64_t* raw, double* physical, uint8_t* valid)
+{
+    uint64_t value = extractRaw(data, sig);
+    raw[handle] = value;
+    physical[handle] = bits::rawToPhysical(value, sig.factor, sig.offset, sig.isSigned, sig.bitLength);
+    valid[handle] = isSna(sig, value) ? 0 : 1;
+}
+
+// ─── Batch decode kernels ───────────────────────────────────
+
+static_assert(sizeof(std::array<uint8_t, 8>) == 8, "payload arrays must be contiguous 8-byte words");
+
+/// Per-column constants shared by all batch kernels
+struct ColumnPlan {
+    bool littleEndian = true;
+    int shift = 0;
+    uint64_t mask = 0;
+    uint64_t signBit = 0;  // 0 for unsigned (and 64-bit) signals, which rawToPhysical doesn't sign-extend
+    double factor = 1.0;
+    double offset = 0.0;
+};
+
+void batchScalar(const uint8_t* payloads, int count, const ColumnPlan& p,
+                 uint64_t* raw, double* physical)
+{
+    for (int i = 0; i < count; ++i) {
+        uint64_t v = (bits::loadWord(payloads + i * 8, p.littleEndian) >> p.shift) & p.mask;
+        raw[i] = v;
+        double x = (v & p.signBit) ? static_cast<double>(static_cast<int64_t>(v | ~p.mask))
+                                   : static_cast<double>(v);
+        physical[i] = x * p.factor + p.offset;
+    }
+}
+
+#ifdef CCS_BATCH_SIMD
+
+// Integer → double without AVX-512: place the value in the mantissa of 2^52
+// (unsigned) or 2^52 + 2^51 (signed) and subtract. Exact while |value| < 2^51 / 2^52,
+// i.e. for signals up to 52 bits; wider columns use the scalar kernel.
+constexpr uint64_t MagicUnsigned = 0x4330000000000000ULL; // 2^52
+constexpr uint64_t MagicSigned = 0x4338000000000000ULL;   // 2^52 + 2^51
+constexpr uint32_t MaxSimdBits = 52;
+
+__attribute__((target("sse4.1")))
+void batchSse41(const uint8_t* payloads, int count, const ColumnPlan& p,
+                uint64_t* raw, double* physical)
+{
+    const __m128i bswap = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m128i shift = _mm_cvtsi32_si128(p.shift);
+    const __m128i mask = _mm_set1_epi64x(static_cast<int64_t>(p.mask));
+    const __m128i sign = _mm_set1_epi64x(static_cast<int64_t>(p.signBit));
+    const __m128i magicU = _mm_set1_epi64x(static_cast<int64_t>(MagicUnsigned));
+    const __m128i magicS = _mm_set1_epi64x(static_cast<int64_t>(MagicSigned));
+    const __m128d magicUd = _mm_castsi128_pd(magicU);
+    const __m128d magicSd = _mm_castsi128_pd(magicS);
+    const __m128d factor = _mm_set1_pd(p.factor);
+    const __m128d offset = _mm_set1_pd(p.offset);
+
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(payloads + i * 8));
+        if (!p.littleEndian) w = _mm_shuffle_epi8(w, bswap);
+        __m128i v = _mm_and_si128(_mm_srl_epi64(w, shift), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(raw + i), v);
+
+        __m128d x;
+        if (p.signBit) {
+            __m128i sv = _mm_sub_epi64(_mm_xor_si128(v, sign), sign);
+            x = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(sv, magicS)), magicSd);
+        } else {
+            x = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(v, magicU)), magicUd);
+        }
+        _mm_storeu_pd(physical + i, _mm_add_pd(_mm_mul_pd(x, factor), offset));
+    }
+    batchScalar(payloads + i * 8, count - i, p, raw + i, physical + i);
+}
+
+__attribute__((target("avx2")))
+void batchAvx2(const uint8_t* payloads, int count, const ColumnPlan& p,
+               uint64_t* raw, double* physical)
+{
+    const __m256i bswap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                           7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m128i shift = _mm_cvtsi32_si128(p.shift);
+    const __m256i mask = _mm256_set1_epi64x(static_cast<int64_t>(p.mask));
+    const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(p.signBit));
+    const __m256i magicU = _mm256_set1_epi64x(static_cast<int64_t>(MagicUnsigned));
+    const __m256i magicS = _mm256_set1_epi64x(static_cast<int64_t>(MagicSigned));
+    const __m256d magicUd = _mm256_castsi256_pd(magicU);
+    const __m256d magicSd = _mm256_castsi256_pd(magicS);
+    const __m256d factor = _mm256_set1_pd(p.factor);
+    const __m256d offset = _mm256_set1_pd(p.offset);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(payloads + i * 8));
+        if (!p.littleEndian) w = _mm256_shuffle_epi8(w, bswap);
+        __m256i v = _mm256_and_si256(_mm256_srl_epi64(w, shift), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(raw + i), v);
+
+        __m256d x;
+        if (p.signBit) {
+            __m256i sv = _mm256_sub_epi64(_mm256_xor_si256(v, sign), sign);
+            x = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(sv, magicS)), magicSd);
+        } else {
+            x = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(v, magicU)), magicUd);
+        }
+        _mm256_storeu_pd(physical + i, _mm256_add_pd(_mm256_mul_pd(x, factor), offset));
+    }
+    batchScalar(payloads + i * 8, count - i, p, raw + i, physical + i);
+}
+
+#endif // CCS_BATCH_SIMD
+
+bool batchKernelSupported(BatchKernel kernel)
+{
+    switch (kernel) {
+    case BatchKernel::Auto:
+    case BatchKernel::Scalar:
+        return true;
+#ifdef CCS_BATCH_SIMD
+    case BatchKernel::Sse41:
+        return __builtin_cpu_supports("sse4.1");
+    case BatchKernel::Avx2:
+        return __builtin_cpu_supports("avx2");
+#else
+    case BatchKernel::Sse41:
+    case BatchKernel::Avx2:
+        return false;
+#endif
+    }
+    return false;
+}
+
+} // namespace
+
 DecodedMessage SignalCodec::decode(const CanFrame& frame) const
 {
     DecodedMessage result;
@@ -16,35 +189,154 @@ DecodedMessage SignalCodec::decode(const CanFrame& frame) const
 
     result.messageName = msg->name;
 
-    for (const auto& sig : msg->dbcSignals) {
-        result.decodedSignals.append(decodeSignal(frame, sig));
+    if (msg->muxSignalIndex < 0) {
+        result.decodedSignals.reserve(msg->dbcSignals.size());
+        for (const auto& sig : msg->dbcSignals) {
+            result.decodedSignals.append(decodeSignal(frame, sig));
+        }
+        return result;
+    }
+
+    // Multiplexed: always-present signals first (the multiplexor is one of them),
+    // then only the group selected by the multiplexor's raw value.
+    uint64_t selector = 0;
+    for (int idx : msg->plainSignals) {
+        result.decodedSignals.append(decodeSignal(frame, msg->dbcSignals[idx]));
+        if (idx == msg->muxSignalIndex) {
+            selector = result.decodedSignals.last().rawValue;
+        }
+    }
+    if (selector < static_cast<uint64_t>(msg->muxGroups.size())) {
+        for (int idx : msg->muxGroups[static_cast<int>(selector)]) {
+            result.decodedSignals.append(decodeSignal(frame, msg->dbcSignals[idx]));
+        }
     }
 
     return result;
 }
 
+const DbcMessage* SignalCodec::decodeInto(const CanFrame& frame, SignalBuffer& out) const
+{
+    if (!m_db) return nullptr;
+
+    const auto* msg = m_db->findMessage(frame.id);
+    if (!msg || msg->firstHandle < 0) return nullptr;
+    if (msg->firstHandle + msg->dbcSignals.size() > out.raw.size()) return nullptr;
+
+    const uint8_t* data = frame.data.data();
+    uint64_t* raw = out.raw.data();
+    double* physical = out.physical.data();
+    uint8_t* valid = out.valid.data();
+
+    if (msg->muxSignalIndex < 0) {
+        for (int i = 0; i < msg->dbcSignals.size(); ++i) {
+            decodeSlot(data, msg->dbcSignals[i], msg->firstHandle + i, raw, physical, valid);
+        }
+        return msg;
+    }
+
+    for (int idx : msg->plainSignals) {
+        decodeSlot(data, msg->dbcSignals[idx], msg->firstHandle + idx, raw, physical, valid);
+    }
+    uint64_t selector = raw[msg->firstHandle + msg->muxSignalIndex];
+    if (selector < static_cast<uint64_t>(msg->muxGroups.size())) {
+        for (int idx : msg->muxGroups[static_cast<int>(selector)]) {
+            decodeSlot(data, msg->dbcSignals[idx], msg->firstHandle + idx, raw, physical, valid);
+        }
+    }
+    return msg;
+}
+
+BatchKernel SignalCodec::bestBatchKernel()
+{
+    static const BatchKernel best = batchKernelSupported(BatchKernel::Avx2)  ? BatchKernel::Avx2
+                                  : batchKernelSupported(BatchKernel::Sse41) ? BatchKernel::Sse41
+                                                                             : BatchKernel::Scalar;
+    return best;
+}
+
+bool SignalCodec::decodeBatch(uint32_t canId, const std::array<uint8_t, 8>* payloads, int frameCount,
+                              BatchColumns& out, BatchKernel kernel) const
+{
+    if (!m_db) return false;
+
+    const auto* msg = m_db->findMessage(canId);
+    if (!msg) return false;
+
+    if (kernel == BatchKernel::Auto) kernel = bestBatchKernel();
+    if (!batchKernelSupported(kernel)) kernel = BatchKernel::Scalar;
+
+    const int count = std::max(frameCount, 0);
+    const int signalCount = static_cast<int>(msg->dbcSignals.size());
+    out.frameCount = count;
+    out.signalCount = signalCount;
+    out.raw.resize(static_cast<qsizetype>(signalCount) * count);
+    out.physical.resize(static_cast<qsizetype>(signalCount) * count);
+    if (count == 0) return true;
+
+    const uint8_t* bytes = payloads->data();
+    for (int s = 0; s < signalCount; ++s) {
+        const DbcSignal& sig = msg->dbcSignals[s];
+        uint64_t* raw = out.raw.data() + static_cast<qsizetype>(s) * count;
+        double* physical = out.physical.data() + static_cast<qsizetype>(s) * count;
+
+        // Signals without a validated layout keep the reference bit loop
+        if (!sig.layoutValid) {
+            for (int i = 0; i < count; ++i) {
+                raw[i] = extractBits(bytes + i * 8, sig.startBit, sig.bitLength, sig.littleEndian);
+                physical[i] = rawToPhysical(raw[i], sig.factor, sig.offset, sig.isSigned, sig.bitLength);
+            }
+            continue;
+        }
+
+        ColumnPlan plan;
+        plan.littleEndian = sig.littleEndian;
+        plan.shift = sig.planShift;
+        plan.mask = sig.planMask;
+        plan.signBit = (sig.isSigned && sig.bitLength > 0 && sig.bitLength < 64) ? (1ULL << (sig.bitLength - 1)) : 0;
+        plan.factor = sig.factor;
+        plan.offset = sig.offset;
+
+#ifdef CCS_BATCH_SIMD
+        if (sig.bitLength <= MaxSimdBits && std::endian::native == std::endian::little) {
+            if (kernel == BatchKernel::Avx2) {
+                batchAvx2(bytes, count, plan, raw, physical);
+                continue;
+            }
+            if (kernel == BatchKernel::Sse41) {
+                batchSse41(bytes, count, plan, raw, physical);
+                continue;
+            }
+        }
+#endif
+        batchScalar(bytes, count, plan, raw, physical);
+    }
+    return true;
+}
+
+QString SignalCodec::valueDescription(const DbcSignal& sig, uint64_t raw) const
+{
+    return m_db ? m_db->valueText(sig, raw) : QString();
+}
+
 DecodedSignal SignalCodec::decodeSignal(const CanFrame& frame, const DbcSignal& sig) const
 {
     DecodedSignal result;
     result.name = sig.name;
     result.unit = sig.unit;
 
-    uint64_t raw = extractBits(frame.data.data(), sig.startBit, sig.bitLength, sig.littleEndian);
+    uint64_t raw = extractRaw(frame.data.data(), sig);
     result.rawValue = raw;
 
     result.physicalValue = rawToPhysical(raw, sig.factor, sig.offset, sig.isSigned, sig.bitLength);
 
-    // Check value descriptions
-    int rawInt = static_cast<int>(raw);
-    if (sig.valueDescriptions.contains(rawInt)) {
-        result.valueDescription = sig.valueDescriptions[rawInt];
-    }
-
-    // Check if this is SNA (Signal Not Available)
-    // SNA is typically the max value for the bit length, or explicitly listed
-    if (result.valueDescription == "SNA") {
-        result.isValid = false;
+    // Value-table text (shared string, no copy) and SNA check from the tables
+    // compiled at load time
+    if (m_db) {
+        int textIndex = DbcDatabase::valueTextIndex(sig, raw);
+        if (textIndex >= 0) result.valueDescription = m_db->stringTable[textIndex];
     }
+    result.isValid = !isSna(sig, raw);
 
     return result;
 }
@@ -55,9 +347,14 @@ bool SignalCodec::encodeSignal(CanFrame& frame, const DbcSignal& sig, double phy
     double clamped = std::clamp(physicalValue, sig.minimum, sig.maximum);
     uint64_t raw = physicalToRaw(clamped, sig.factor, sig.offset);
 
+    // Validated at load time: the clamped range already fits the bit width
+    if (sig.rawRangeFits) {
+        insertPlanned(frame.data.data(), sig, raw);
+        return true;
+    }
+
     // Clamp to bit width
-    uint64_t maxVal = (sig.bitLength >= 64) ? UINT64_MAX : ((1ULL << sig.bitLength) - 1);
-    if (raw > maxVal) raw = maxVal;
+    raw = saturateRaw(sig, raw);
 
     insertBits(frame.data.data(), sig.startBit, sig.bitLength, sig.littleEndian, raw);
     return true;
@@ -68,116 +365,101 @@ bool SignalCodec::encodeSignalRaw(CanFrame& frame, const DbcSignal& sig, uint64_
     uint64_t maxVal = (sig.bitLength >= 64) ? UINT64_MAX : ((1ULL << sig.bitLength) - 1);
     if (rawValue > maxVal) rawValue = maxVal;
 
-    insertBits(frame.data.data(), sig.startBit, sig.bitLength, sig.littleEndian, rawValue);
+    if (sig.layoutValid) {
+        insertPlanned(frame.data.data(), sig, rawValue);
+    } else {
+        insertBits(frame.data.data(), sig.startBit, sig.bitLength, sig.littleEndian, rawValue);
+    }
     return true;
 }
 
-uint64_t SignalCodec::extractBits(const uint8_t* data, uint32_t startBit,
-                                   uint32_t bitLength, bool littleEndian)
+bool SignalCodec::encodeSignalFixed(CanFrame& frame, const DbcSignal& sig, int64_t scaledValue) const
 {
-    uint64_t result = 0;
-
-    if (littleEndian) {
-        // Intel byte order: startBit is the LSB position
-        for (uint32_t i = 0; i < bitLength; ++i) {
-            uint32_t bitPos = startBit + i;
-            uint32_t byteIdx = bitPos / 8;
-            uint32_t bitIdx = bitPos % 8;
-            if (byteIdx < 8) {
-                if (data[byteIdx] & (1 << bitIdx)) {
-                    result |= (1ULL << i);
-                }
-            }
-        }
-    }
-    else {
-        // Motorola byte order: startBit is the MSB position
-        // Convert Motorola start bit to bit positions
-        for (uint32_t i = 0; i < bitLength; ++i) {
-            uint32_t byteNum = startBit / 8;
-            uint32_t bitNum = startBit % 8;
+    if (!sig.fixedPointExact) return false;
 
-            // Calculate the actual bit position for the i-th bit (MSB first)
-            int srcByte = static_cast<int>(byteNum);
-            int srcBit = static_cast<int>(bitNum) - static_cast<int>(i);
+    int64_t clamped = std::clamp(scaledValue, sig.fixedMinimum, sig.fixedMaximum);
+    uint64_t raw = fixedToRaw(sig, clamped);
 
-            while (srcBit < 0) {
-                srcByte++;
-                srcBit += 8;
-            }
+    if (sig.rawRangeFits) {
+        insertPlanned(frame.data.data(), sig, raw);
+        return true;
+    }
 
-            if (srcByte < 8 && srcByte >= 0) {
-                if (data[srcByte] & (1 << srcBit)) {
-                    result |= (1ULL << (bitLength - 1 - i));
-                }
-            }
-        }
+    raw = saturateRaw(sig, raw);
+
+    if (sig.layoutValid) {
+        insertPlanned(frame.data.data(), sig, raw);
+    } else {
+        insertBits(frame.data.data(), sig.startBit, sig.bitLength, sig.littleEndian, raw);
     }
+    return true;
+}
 
-    return result;
+bool SignalCodec::decodeSignalFixed(const CanFrame& frame, const DbcSignal& sig, int64_t& scaledValue) const
+{
+    if (!sig.fixedPointExact) return false;
+    scaledValue = rawToFixed(sig, extractRaw(frame.data.data(), sig));
+    return true;
+}
+
+uint64_t SignalCodec::extractBits(const uint8_t* data, uint32_t startBit,
+                                   uint32_t bitLength, bool littleEndian)
+{
+    return bits::extract(data, startBit, bitLength, littleEndian);
 }
 
 void SignalCodec::insertBits(uint8_t* data, uint32_t startBit,
                               uint32_t bitLength, bool littleEndian, uint64_t value)
 {
-    if (littleEndian) {
-        for (uint32_t i = 0; i < bitLength; ++i) {
-            uint32_t bitPos = startBit + i;
-            uint32_t byteIdx = bitPos / 8;
-            uint32_t bitIdx = bitPos % 8;
-            if (byteIdx < 8) {
-                if (value & (1ULL << i)) {
-                    data[byteIdx] |= (1 << bitIdx);
-                } else {
-                    data[byteIdx] &= ~(1 << bitIdx);
-                }
-            }
-        }
-    }
-    else {
-        for (uint32_t i = 0; i < bitLength; ++i) {
-            uint32_t byteNum = startBit / 8;
-            uint32_t bitNum = startBit % 8;
+    bits::insert(data, startBit, bitLength, littleEndian, value);
+}
 
-            int srcByte = static_cast<int>(byteNum);
-            int srcBit = static_cast<int>(bitNum) - static_cast<int>(i);
+uint64_t SignalCodec::extractPlanned(const uint8_t* data, const DbcSignal& sig)
+{
+    return bits::extractPlanned(data, sig.littleEndian, sig.planShift, sig.planMask);
+}
 
-            while (srcBit < 0) {
-                srcByte++;
-                srcBit += 8;
-            }
+void SignalCodec::insertPlanned(uint8_t* data, const DbcSignal& sig, uint64_t value)
+{
+    bits::insertPlanned(data, sig.littleEndian, sig.planShift, sig.planMask, value);
+}
 
-            if (srcByte < 8 && srcByte >= 0) {
-                if (value & (1ULL << (bitLength - 1 - i))) {
-                    data[srcByte] |= (1 << srcBit);
-                } else {
-                    data[srcByte] &= ~(1 << srcBit);
-                }
-            }
-        }
+uint64_t SignalCodec::physicalToRaw(double physical, double factor, double offset)
+{
+    return bits::physicalToRaw(physical, factor, offset);
+}
+
+int64_t SignalCodec::rawToFixed(const DbcSignal& sig, uint64_t raw)
+{
+    int64_t value = static_cast<int64_t>(raw);
+    if (sig.isSigned && (raw & (1ULL << (sig.bitLength - 1)))) {
+        value = static_cast<int64_t>(raw | (~0ULL << sig.bitLength));
     }
+    return value * sig.fixedFactor + sig.fixedOffset;
 }
 
-uint64_t SignalCodec::physicalToRaw(double physical, double factor, double offset)
+uint64_t SignalCodec::fixedToRaw(const DbcSignal& sig, int64_t scaledValue)
 {
-    if (factor == 0.0) return 0;
-    double raw = (physical - offset) / factor;
-    return static_cast<uint64_t>(std::round(raw));
+    int64_t num = scaledValue - sig.fixedOffset;
+    int64_t den = sig.fixedFactor;
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+
+    // Integer division truncates toward zero; round half away from zero like std::round
+    int64_t quotient = num / den;
+    int64_t remainder = num % den;
+    if (2 * (remainder < 0 ? -remainder : remainder) >= den) {
+        quotient += (num < 0) ? -1 : 1;
+    }
+    return static_cast<uint64_t>(quotient);
 }
 
 double SignalCodec::rawToPhysical(uint64_t raw, double factor, double offset,
                                    bool isSigned, uint32_t bitLength)
 {
-    if (isSigned && bitLength < 64) {
-        // Sign-extend
-        uint64_t signBit = 1ULL << (bitLength - 1);
-        if (raw & signBit) {
-            // Negative value - sign extend
-            int64_t signedRaw = static_cast<int64_t>(raw | (~0ULL << bitLength));
-            return static_cast<double>(signedRaw) * factor + offset;
-        }
-    }
-    return static_cast<double>(raw) * factor + offset;
+    return bits::rawToPhysical(raw, factor, offset, isSigned, bitLength);
 }
 
 } // namespace ccs
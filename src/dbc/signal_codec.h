@@ -4,6 +4,7 @@
 #include "can/can_frame.h"
 #include <QMap>
 #include <QString>
+#include <array>
 #include <cstdint>
 
 namespace ccs {
@@ -25,16 +26,68 @@ struct DecodedMessage {
     QVector<DecodedSignal> decodedSignals;
 };
 
+/// Caller-owned decode target in structure-of-arrays form, indexed by signal handle
+/// (DbcMessage::firstHandle + signal index). Size it once with resize(); decodeInto()
+/// then fills it without allocating. Names, units and value descriptions are not
+/// copied — look them up through DbcDatabase::signalByHandle() when displaying.
+struct SignalBuffer {
+    QVector<uint64_t> raw;
+    QVector<double> physical;
+    QVector<uint8_t> valid; // 0 if the raw value is the signal's SNA value
+
+    void resize(const DbcDatabase& db) {
+        raw.resize(db.signalCount());
+        physical.resize(db.signalCount());
+        valid.resize(db.signalCount());
+    }
+};
+
+/// Columnar output of SignalCodec::decodeBatch(): column i holds dbcSignals[i]
+/// of the message for every frame, stored contiguously.
+struct BatchColumns {
+    int frameCount = 0;
+    int signalCount = 0;
+    QVector<uint64_t> raw;      // [signal * frameCount + frame]
+    QVector<double> physical;   // [signal * frameCount + frame]
+
+    const uint64_t* rawColumn(int signal) const { return raw.constData() + signal * frameCount; }
+    const double* physicalColumn(int signal) const { return physical.constData() + signal * frameCount; }
+};
+
+/// Kernel used by decodeBatch(). Auto picks the widest one the CPU supports;
+/// an explicit choice falls back to Scalar when unavailable.
+enum class BatchKernel {
+    Auto,
+    Scalar,
+    Sse41,
+    Avx2
+};
+
 class SignalCodec {
 public:
     SignalCodec() = default;
     explicit SignalCodec(const DbcDatabase& db) : m_db(&db) {}
 
     void setDatabase(const DbcDatabase& db) { m_db = &db; }
+    const DbcDatabase* database() const { return m_db; }
 
     /// Decode all signals from a CAN frame using the DBC
     DecodedMessage decode(const CanFrame& frame) const;
 
+    /// Decode all signals of a frame into handle-indexed slots of a buffer sized
+    /// for the database. For multiplexed messages only the always-present signals
+    /// and the active group are written. Returns the message, or nullptr if unknown.
+    const DbcMessage* decodeInto(const CanFrame& frame, SignalBuffer& out) const;
+
+    /// Decode every signal of one message for a run of recorded payloads (offline
+    /// analysis). Multiplexed signals are decoded for every frame; filter them on
+    /// the multiplexor column. Returns false if the message is unknown.
+    bool decodeBatch(uint32_t canId, const std::array<uint8_t, 8>* payloads, int frameCount,
+                     BatchColumns& out, BatchKernel kernel = BatchKernel::Auto) const;
+
+    /// Kernel that decodeBatch() runs for BatchKernel::Auto on this CPU
+    static BatchKernel bestBatchKernel();
+
     /// Decode a single signal from a CAN frame
     DecodedSignal decodeSignal(const CanFrame& frame, const DbcSignal& sig) const;
 
@@ -45,6 +98,19 @@ public:
     /// Encode a raw value directly into a CAN frame
     bool encodeSignalRaw(CanFrame& frame, const DbcSignal& sig, uint64_t rawValue) const;
 
+    /// Integer-only encode/decode for signals with fixedPointExact (no FPU use).
+    /// Values are physical units × 10^sig.fixedDecimals, e.g. 12.5 V at 1 decimal is 125.
+    /// Return false if the signal has no exact fixed-point scaling. Both agree with the
+    /// double path: decodeSignal()'s physicalValue × 10^fixedDecimals rounds to the fixed
+    /// value, and both encoders pick the same raw value, except at an exact half step.
+    /// There encodeSignalFixed() rounds away from zero, while the double division may land
+    /// just below the half (0.3 / 0.2 = 1.4999...) and encodeSignal() rounds the other way.
+    bool encodeSignalFixed(CanFrame& frame, const DbcSignal& sig, int64_t scaledValue) const;
+    bool decodeSignalFixed(const CanFrame& frame, const DbcSignal& sig, int64_t& scaledValue) const;
+
+    /// Value-table text for a raw value (empty if none)
+    QString valueDescription(const DbcSignal& sig, uint64_t raw) const;
+
     /// Extract raw bits from CAN data
     static uint64_t extractBits(const uint8_t* data, uint32_t startBit,
                                 uint32_t bitLength, bool littleEndian);
@@ -53,12 +119,22 @@ public:
     static void insertBits(uint8_t* data, uint32_t startBit,
                            uint32_t bitLength, bool littleEndian, uint64_t value);
 
+    /// Word-level extract/insert using the signal's precompiled plan.
+    /// Only for signals with layoutValid set; data must hold 8 bytes.
+    static uint64_t extractPlanned(const uint8_t* data, const DbcSignal& sig);
+    static void insertPlanned(uint8_t* data, const DbcSignal& sig, uint64_t value);
+
     /// Convert physical value to raw value
     static uint64_t physicalToRaw(double physical, double factor, double offset);
 
     /// Convert raw value to physical value
     static double rawToPhysical(uint64_t raw, double factor, double offset, bool isSigned, uint32_t bitLength);
 
+    /// Fixed-point counterparts of rawToPhysical/physicalToRaw (same sign extension and
+    /// round-half-away-from-zero). Only meaningful when sig.fixedPointExact is set.
+    static int64_t rawToFixed(const DbcSignal& sig, uint64_t raw);
+    static uint64_t fixedToRaw(const DbcSignal& sig, int64_t scaledValue);
+
 private:
     const DbcDatabase* m_db = nullptr;
 };
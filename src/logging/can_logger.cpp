@@ -77,10 +77,10 @@ void CanLogger::writeRawFrame(const CanFrame& frame)
 
     m_rawStream << elapsed << ","
                 << "RX" << ","
-                << frame.idString() << ","
+                << frameIdString(frame) << ","
                 << (frame.extended ? "EXT" : "STD") << ","
                 << frame.dlc << ","
-                << frame.toHexString() << "\n";
+                << frameHexString(frame) << "\n";
 
     if (++m_rawCount % 100 == 0) {
         m_rawStream.flush();
@@ -92,18 +92,36 @@ void CanLogger::writeDecodedFrame(const CanFrame& frame)
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
         frame.timestamp - m_startTime).count();
 
-    auto decoded = m_codec->decode(frame);
-    if (decoded.messageName.isEmpty()) return;
+    const DbcDatabase* db = m_codec->database();
+    if (!db) return;
+    if (m_signals.raw.size() != db->signalCount()) {
+        m_signals.resize(*db);
+    }
+
+    const DbcMessage* msg = m_codec->decodeInto(frame, m_signals);
+    if (!msg) return;
 
-    for (const auto& sig : decoded.decodedSignals) {
+    auto writeSignal = [&](int idx) {
+        const DbcSignal& sig = msg->dbcSignals[idx];
+        int handle = msg->firstHandle + idx;
         m_decodedStream << elapsed << ","
-                        << decoded.messageName << ","
+                        << msg->name << ","
                         << sig.name << ","
-                        << sig.rawValue << ","
-                        << sig.physicalValue << ","
+                        << m_signals.raw[handle] << ","
+                        << m_signals.physical[handle] << ","
                         << sig.unit << ","
-                        << sig.valueDescription << "\n";
+                        << m_codec->valueDescription(sig, m_signals.raw[handle]) << "\n";
         m_decodedCount++;
+    };
+
+    if (msg->muxSignalIndex < 0) {
+        for (int i = 0; i < msg->dbcSignals.size(); ++i) writeSignal(i);
+    } else {
+        for (int idx : msg->plainSignals) writeSignal(idx);
+        uint64_t selector = m_signals.raw[msg->firstHandle + msg->muxSignalIndex];
+        if (selector < static_cast<uint64_t>(msg->muxGroups.size())) {
+            for (int idx : msg->muxGroups[static_cast<int>(selector)]) writeSignal(idx);
+        }
     }
 
     if (m_decodedCount % 100 == 0) {
@@ -41,6 +41,7 @@ private:
     QTextStream m_rawStream;
     QTextStream m_decodedStream;
     const SignalCodec* m_codec = nullptr;
+    SignalBuffer m_signals; // reused for every decoded frame
 
     std::chrono::steady_clock::time_point m_startTime;
     uint64_t m_rawCount = 0;
@@ -23,6 +23,8 @@ void SessionReport::startSession()
     m_endSoC = 0.0;
     m_lastVoltage = 0.0;
     m_lastCurrent = 0.0;
+    m_lastFresh = true;
+    m_staleMs = 0.0;
 }
 
 void SessionReport::endSession()
@@ -31,7 +33,7 @@ void SessionReport::endSession()
     m_endTime = QDateTime::currentDateTime();
 }
 
-void SessionReport::updateValues(double voltage, double current, double soc)
+void SessionReport::updateValues(double voltage, double current, double soc, bool fresh)
 {
     if (!m_active) return;
 
@@ -39,6 +41,19 @@ void SessionReport::updateValues(double voltage, double current, double soc)
     auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastUpdate).count();
     m_lastUpdate = now;
 
+    // SoC tracking
+    if (m_startSoC < 0.0 && soc >= 0.0) {
+        m_startSoC = soc;
+    }
+    m_endSoC = soc;
+
+    if (!fresh) {
+        // Only the last values before the EVSE went quiet are known; count the time, not the energy
+        m_staleMs += dt;
+        m_lastFresh = false;
+        return;
+    }
+
     double power = voltage * current;
 
     // Track maximums
@@ -46,20 +61,15 @@ void SessionReport::updateValues(double voltage, double current, double soc)
     m_maxCurrent = std::max(m_maxCurrent, current);
     m_maxPower = std::max(m_maxPower, power);
 
-    // Energy integration (trapezoidal rule)
-    if (dt > 0 && dt < 5000) { // Ignore gaps > 5s
+    // Energy integration (trapezoidal rule), never across a stale interval
+    if (m_lastFresh && dt > 0 && dt < 5000) { // Ignore gaps > 5s
         double avgPower = (power + m_lastVoltage * m_lastCurrent) / 2.0;
         m_energyWh += avgPower * (dt / 3600000.0); // ms to hours
     }
 
     m_lastVoltage = voltage;
     m_lastCurrent = current;
-
-    // SoC tracking
-    if (m_startSoC < 0.0 && soc >= 0.0) {
-        m_startSoC = soc;
-    }
-    m_endSoC = soc;
+    m_lastFresh = true;
 }
 
 int SessionReport::durationSeconds() const
@@ -90,7 +100,11 @@ bool SessionReport::saveReport(const QString& filePath) const
 
     out << "--- Energy ---\n";
     out << "Energy Delivered: " << QString::number(m_energyWh, 'f', 1) << " Wh ("
-        << QString::number(m_energyWh / 1000.0, 'f', 3) << " kWh)\n\n";
+        << QString::number(m_energyWh / 1000.0, 'f', 3) << " kWh)\n";
+    if (m_staleMs > 0.0) {
+        out << "Stale EVSE Data: " << QString::number(m_staleMs / 1000.0, 'f', 1) << " s (not integrated)\n";
+    }
+    out << "\n";
 
     out << "--- State of Charge ---\n";
     if (m_startSoC >= 0.0) {
@@ -15,7 +15,10 @@ public:
 
     void startSession();
     void endSession();
-    void updateValues(double voltage, double current, double soc);
+    /// Sample of the present EVSE values and EV SoC. With fresh false the EVSE values
+    /// are stale (their frames stopped arriving): the interval is left out of the energy
+    /// estimate and the peaks instead of integrating the last value received.
+    void updateValues(double voltage, double current, double soc, bool fresh);
 
     bool saveReport(const QString& filePath) const;
 
@@ -29,6 +32,8 @@ public:
     double energyEstimateWh() const { return m_energyWh; }
     double startSoC() const { return m_startSoC; }
     double endSoC() const { return m_endSoC; }
+    /// Time sampled while the EVSE values were stale
+    double staleSeconds() const { return m_staleMs / 1000.0; }
     int durationSeconds() const;
 
 private:
@@ -45,6 +50,8 @@ private:
     double m_endSoC = 0.0;
     double m_lastVoltage = 0.0;
     double m_lastCurrent = 0.0;
+    bool m_lastFresh = true;
+    double m_staleMs = 0.0;
 };
 
 } // namespace ccs
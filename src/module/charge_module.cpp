@@ -1,9 +1,30 @@
 #include "module/charge_module.h"
 #include <QDebug>
-#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <utility>
 
 namespace ccs {
 
+namespace {
+
+/// Store value in field; true when it differs from what was there
+template <typename T>
+bool assign(T& field, T value)
+{
+    if (field == value) return false;
+    field = value;
+    return true;
+}
+
+/// Receive time as stored in ChargeModule::m_evseFieldTimeNs
+int64_t toNanoseconds(std::chrono::steady_clock::time_point timestamp)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+} // namespace
+
 // CAN IDs (extended) per DBC
 namespace canid {
     constexpr uint32_t ChargeInfo            = 0x0600;
@@ -22,73 +43,157 @@ namespace canid {
     constexpr uint32_t ModuleReset           = 0x0667; // Standard frame!
 }
 
-ChargeModule::ChargeModule(QObject* parent)
+ChargeModule::ChargeModule(QObject* parent, Drive drive)
     : QObject(parent)
+    , m_drive(drive)
+    , m_safety(this) // child, so moveToThread() takes the monitor and its watchdog along
 {
-    m_cyclicTimer = new QTimer(this);
-    m_cyclicTimer->setInterval(100); // 100ms cycle per DBC
-    connect(m_cyclicTimer, &QTimer::timeout, this, &ChargeModule::onCyclicTx);
+    if (drive == Drive::Standalone) {
+        m_notifyTimer = new QTimer(this);
+        m_notifyTimer->setSingleShot(true);
+        connect(m_notifyTimer, &QTimer::timeout, this, [this] { flushEvseChanges(std::chrono::steady_clock::now()); });
+
+        m_txScheduler = new TxScheduler(this);
+        m_txScheduler->setSendFunction([this](int entry) { onTxDue(static_cast<TxMessage>(entry)); });
+    } else {
+        m_safety.setWatchdogTimerEnabled(false);
+    }
+    buildTxImages(); // frame headers only until a DBC provides the signals
 
-    // Safety monitor connections
+    // Safety monitor connections. Direct: a Pooled module raises the stop on a
+    // worker thread, and the safe state must not wait for this object's thread.
     connect(&m_safety, &SafetyMonitor::emergencyStopTriggered, this, [this](const QString& reason) {
-        qWarning() << "Safety: Emergency stop -" << reason;
-        // Immediately set EVReady=false, ChargeProgressIndication=Stop
-        m_evParams.evReady = false;
-        m_evParams.chargeProgress = ChargeProgressIndication::Stop;
-        m_evParams.chargeStop = ChargeStopIndication::Terminate;
-        // Send immediately
-        if (m_running) {
-            sendEvStatusControl();
+        // Raised while a received frame is processed: the safe state is its reaction
+        LatencyTrace::Stamps* trace = isOnModuleThread() ? m_rxTrace : nullptr;
+        bool sent = false;
+        {
+            // Immediately set EVReady=false, ChargeProgressIndication=Stop
+            QMutexLocker lock(&m_mutex);
+            drainCommands(); // earlier setter calls must not land after the safe state
+            applySafeState();
+            // Send immediately
+            if (m_running) {
+                sendTxMessage(TxMessage::EvStatusControl, trace);
+                sent = true;
+            }
+        }
+        if (trace && sent) {
+            m_latencyTrace.record(LatencyTrace::Path::EmergencyStop, *trace);
         }
-    });
+        qWarning() << "Safety: Emergency stop -" << reason; // after the send, logging is slow
+    }, Qt::DirectConnection);
+}
+
+ChargeModule::~ChargeModule()
+{
+    // The scheduler thread calls back into this object
+    if (m_txScheduler) m_txScheduler->stopScheduling();
 }
 
 void ChargeModule::setCanInterface(CanInterface* iface)
 {
+    if (!isOnModuleThread()) {
+        QMetaObject::invokeMethod(this, [this, iface] { setCanInterface(iface); },
+                                  Qt::BlockingQueuedConnection);
+        return;
+    }
+
     if (m_can) {
         disconnect(m_can, &CanInterface::frameReceived, this, &ChargeModule::onFrameReceived);
     }
-    m_can = iface;
-    if (m_can) {
-        connect(m_can, &CanInterface::frameReceived, this, &ChargeModule::onFrameReceived,
+    {
+        // The TX side reads it on the scheduler thread, under the lock
+        QMutexLocker lock(&m_mutex);
+        m_can = iface;
+    }
+    if (iface && m_drive == Drive::Standalone) {
+        connect(iface, &CanInterface::frameReceived, this, &ChargeModule::onFrameReceived,
                 Qt::QueuedConnection);
     }
 }
 
 void ChargeModule::loadDbc(const QString& dbcPath)
 {
+    if (!isOnModuleThread()) {
+        QMetaObject::invokeMethod(this, [this, dbcPath] { loadDbc(dbcPath); },
+                                  Qt::BlockingQueuedConnection);
+        return;
+    }
+
     DbcParser parser;
     if (parser.parse(dbcPath)) {
-        m_dbc = parser.database();
-        m_codec.setDatabase(m_dbc);
+        setDatabase(parser.database());
         qDebug() << "DBC loaded:" << m_dbc.name << "with" << m_dbc.messages.size() << "messages";
+        for (const auto& warning : m_bindingWarnings) {
+            qWarning() << "DBC binding:" << warning;
+        }
     } else {
         qWarning() << "Failed to load DBC:" << parser.lastError();
     }
 }
 
+void ChargeModule::setDatabase(const DbcDatabase& database)
+{
+    if (!isOnModuleThread()) {
+        QMetaObject::invokeMethod(this, [this, &database] { setDatabase(database); },
+                                  Qt::BlockingQueuedConnection);
+        return;
+    }
+
+    // TX bindings point into m_dbc: stop the scheduler thread while it is replaced.
+    // A Pooled module's owner must not call serviceTx() meanwhile.
+    bool wasScheduling = m_txScheduler && m_txScheduler->isScheduling();
+    if (m_txScheduler) m_txScheduler->stopScheduling();
+    QMutexLocker lock(&m_mutex);
+
+    m_dbc = database;
+    m_codec.setDatabase(m_dbc);
+    m_bindingWarnings.clear();
+    buildTxImages();
+    m_decoder.setLayout(m_dbc.layout());
+    buildRxTables();
+    buildTimeoutMonitors();
+
+    if (wasScheduling) {
+        m_txScheduler->setEntries(txSchedule());
+        m_txScheduler->startScheduling();
+    }
+}
+
 void ChargeModule::start()
 {
+    if (!isOnModuleThread()) {
+        QMetaObject::invokeMethod(this, [this] { start(); }, Qt::BlockingQueuedConnection);
+        return;
+    }
     if (m_running) return;
 
     // Initialize EV parameters to safe defaults (SNA values where appropriate)
     // Per datasheet: CMS will not start until mandatory signals are non-SNA
     m_running = true;
-    m_cyclicTimer->start();
-    qDebug() << "ChargeModule: cyclic TX started (100ms)";
+    if (m_txScheduler) {
+        m_txScheduler->setEntries(txSchedule());
+        m_txScheduler->startScheduling();
+    }
+    qDebug() << "ChargeModule: cyclic TX started";
 }
 
 void ChargeModule::stop()
 {
+    if (!isOnModuleThread()) {
+        QMetaObject::invokeMethod(this, [this] { stop(); }, Qt::BlockingQueuedConnection);
+        return;
+    }
     m_running = false;
-    m_cyclicTimer->stop();
+    if (m_txScheduler) m_txScheduler->stopScheduling();
+    m_sequencer.reset();
 
     // Send safe state: EVReady=false, ChargeProgress=Stop, ChargeStop=Terminate
-    m_evParams.evReady = false;
-    m_evParams.chargeProgress = ChargeProgressIndication::Stop;
-    m_evParams.chargeStop = ChargeStopIndication::Terminate;
+    QMutexLocker lock(&m_mutex);
+    drainCommands();
+    applySafeState();
     if (m_can && m_can->isOpen()) {
-        sendEvStatusControl();
+        sendTxMessage(TxMessage::EvStatusControl);
     }
 
     qDebug() << "ChargeModule: stopped, safe state sent";
@@ -98,140 +203,203 @@ void ChargeModule::stop()
 
 void ChargeModule::setEvMaxVoltage(double v)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evMaxVoltage = m_safety.clampVoltage(v);
+    postParam(TxField::EvMaxVoltage, m_safety.clampVoltage(v));
 }
 
 void ChargeModule::setEvMaxCurrent(double i)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evMaxCurrent = m_safety.clampCurrent(i);
+    postParam(TxField::EvMaxCurrent, m_safety.clampCurrent(i));
 }
 
 void ChargeModule::setEvMaxPower(double p)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evMaxPower = m_safety.clampPower(p);
+    postParam(TxField::EvMaxPower, m_safety.clampPower(p));
 }
 
 void ChargeModule::setEvTargetVoltage(double v)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evTargetVoltage = m_safety.clampVoltage(v);
+    postParam(TxField::EvTargetVoltage, m_safety.clampVoltage(v));
 }
 
 void ChargeModule::setEvTargetCurrent(double i)
 {
-    QMutexLocker lock(&m_mutex);
-    // During PreCharge, target current is fixed at 2A per datasheet
-    if (m_evseData.stateMachineState == CmsState::PreCharge) {
-        m_evParams.evTargetCurrent = std::min(i, 2.0);
-    } else {
-        m_evParams.evTargetCurrent = m_safety.clampCurrent(i);
-    }
+    // The PreCharge limit is applied when the command is drained, see applyParam()
+    postParam(TxField::EvTargetCurrent, m_safety.clampCurrent(i));
 }
 
 void ChargeModule::setEvPreChargeVoltage(double v)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evPreChargeVoltage = m_safety.clampVoltage(v);
+    postParam(TxField::EvPreChargeVoltage, m_safety.clampVoltage(v));
 }
 
 void ChargeModule::setEvSoC(double soc)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evSoC = std::clamp(soc, 0.0, 100.0);
+    postParam(TxField::EvSoC, std::clamp(soc, 0.0, 100.0));
 }
 
 void ChargeModule::setEvReady(bool ready)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evReady = ready;
+    postParam(TxField::EvReady, ready ? 1.0 : 0.0);
 }
 
 void ChargeModule::setChargeProgressIndication(ChargeProgressIndication ind)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.chargeProgress = ind;
+    postParam(TxField::ChargeProgress, static_cast<double>(ind));
 }
 
 void ChargeModule::setChargeStopIndication(ChargeStopIndication ind)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.chargeStop = ind;
+    postParam(TxField::ChargeStop, static_cast<double>(ind));
 }
 
 void ChargeModule::setWeldingDetectionEnable(bool enable)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evWeldingDetectionEnable = enable;
+    postParam(TxField::EvWeldingDetectionEnable, enable ? 1.0 : 0.0);
 }
 
 void ChargeModule::setEvErrorCode(uint8_t code)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evErrorCode = code;
+    postParam(TxField::EvErrorCode, code);
 }
 
 void ChargeModule::setEvFullSoC(double soc)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evFullSoC = std::clamp(soc, 0.0, 100.0);
+    postParam(TxField::EvFullSoC, std::clamp(soc, 0.0, 100.0));
 }
 
 void ChargeModule::setEvBulkSoC(double soc)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evBulkSoC = std::clamp(soc, 0.0, 100.0);
+    postParam(TxField::EvBulkSoC, std::clamp(soc, 0.0, 100.0));
 }
 
 void ChargeModule::setEvEnergyCapacity(double wh)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evEnergyCapacity = std::clamp(wh, 0.0, 3276700.0);
+    postParam(TxField::EvEnergyCapacity, std::clamp(wh, 0.0, 3276700.0));
 }
 
 void ChargeModule::setEvEnergyRequest(double wh)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evEnergyRequest = std::clamp(wh, 0.0, 3276700.0);
+    postParam(TxField::EvEnergyRequest, std::clamp(wh, 0.0, 3276700.0));
 }
 
 void ChargeModule::setChargeProtocolPriority(uint8_t prio)
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.chargeProtocolPriority = prio;
+    postParam(TxField::ChargeProtocolPriority, prio);
+}
+
+void ChargeModule::postCommand(const ParamCommand& command)
+{
+    // Full only when nothing drained it for CommandQueueCapacity calls: make room here
+    while (!m_commands.push(command)) {
+        QMutexLocker lock(&m_mutex);
+        drainCommands();
+    }
+
+    // Stopped, no cyclic send drains the queue. The fence pairs with stop(): either
+    // this sees m_running false, or stop()'s drain sees the command.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_running) {
+        QMutexLocker lock(&m_mutex);
+        drainCommands();
+    }
+}
+
+void ChargeModule::drainCommands()
+{
+    // m_mutex held: one consumer at a time. Repeated calls for a field since the
+    // last drain just overwrite it; it is encoded and published once.
+    ParamCommand command;
+    bool applied = false;
+    while (m_commands.pop(command)) {
+        switch (command.op) {
+            case ParamCommand::Op::Set:
+                applyParam(command.field, command.value);
+                break;
+            case ParamCommand::Op::StartCharging:
+                m_evParams.evReady = true;
+                m_evParams.chargeStop = ChargeStopIndication::NoStop;
+                m_evParams.evErrorCode = 0; // NO_ERROR
+                markDirty(TxField::EvReady);
+                markDirty(TxField::ChargeStop);
+                markDirty(TxField::EvErrorCode);
+                break;
+            case ParamCommand::Op::StopCharging:
+                // Per datasheet: set ChargeProgressIndication to Stop, then ChargeStopIndication to Terminate
+                m_evParams.chargeProgress = ChargeProgressIndication::Stop;
+                m_evParams.chargeStop = ChargeStopIndication::Terminate;
+                markDirty(TxField::ChargeProgress);
+                markDirty(TxField::ChargeStop);
+                break;
+        }
+        applied = true;
+    }
+    if (applied) publishEvParams();
+}
+
+void ChargeModule::applyParam(TxField field, double value)
+{
+    auto& p = m_evParams;
+    switch (field) {
+        case TxField::EvMaxCurrent:       p.evMaxCurrent = value; break;
+        case TxField::EvMaxVoltage:       p.evMaxVoltage = value; break;
+        case TxField::EvMaxPower:         p.evMaxPower = value; break;
+        case TxField::EvFullSoC:          p.evFullSoC = value; break;
+        case TxField::EvBulkSoC:          p.evBulkSoC = value; break;
+        case TxField::EvTargetCurrent:
+            // During PreCharge, target current is fixed at 2A per datasheet. Checked here
+            // rather than at the setter, whose view of the state may be stale by now.
+            p.evTargetCurrent = m_paramState == CmsState::PreCharge
+                                    ? std::min(value, ChargeSequencer::PreChargeCurrentA) : value;
+            break;
+        case TxField::EvTargetVoltage:    p.evTargetVoltage = value; break;
+        case TxField::EvPreChargeVoltage: p.evPreChargeVoltage = value; break;
+        case TxField::ChargeProgress:
+            p.chargeProgress = static_cast<ChargeProgressIndication>(static_cast<int>(value)); break;
+        case TxField::ChargeStop:
+            p.chargeStop = static_cast<ChargeStopIndication>(static_cast<int>(value)); break;
+        case TxField::EvReady:            p.evReady = value != 0.0; break;
+        case TxField::EvWeldingDetectionEnable: p.evWeldingDetectionEnable = value != 0.0; break;
+        case TxField::ChargeProtocolPriority: p.chargeProtocolPriority = static_cast<uint8_t>(value); break;
+        case TxField::EvSoC:              p.evSoC = value; break;
+        case TxField::EvErrorCode:        p.evErrorCode = static_cast<uint8_t>(value); break;
+        case TxField::EvEnergyCapacity:   p.evEnergyCapacity = value; break;
+        case TxField::EvEnergyRequest:    p.evEnergyRequest = value; break;
+        default: return; // no setter posts the remaining fields
+    }
+    markDirty(field);
 }
 
 // ─── High-level actions ──────────────────────────────────
 
 void ChargeModule::requestStartCharging()
 {
-    QMutexLocker lock(&m_mutex);
-    m_evParams.evReady = true;
-    m_evParams.chargeStop = ChargeStopIndication::NoStop;
-    m_evParams.evErrorCode = 0; // NO_ERROR
-    // ChargeProgressIndication will be set to Start when VoltageMatch is True (PreCharge→Charge transition)
+    postCommand({ParamCommand::Op::StartCharging});
+    // ChargeProgressIndication will be set to Start on the first ChargeInfo in PreCharge
+    // with VoltageMatch True (PreCharge→Charge transition)
     qDebug() << "ChargeModule: Charging requested";
 }
 
 void ChargeModule::requestStopCharging()
 {
-    QMutexLocker lock(&m_mutex);
-    // Per datasheet: set ChargeProgressIndication to Stop, then ChargeStopIndication to Terminate
-    m_evParams.chargeProgress = ChargeProgressIndication::Stop;
-    m_evParams.chargeStop = ChargeStopIndication::Terminate;
+    postCommand({ParamCommand::Op::StopCharging});
     qDebug() << "ChargeModule: Stop charging requested";
 }
 
 void ChargeModule::emergencyStop()
 {
+    if (!isOnModuleThread()) {
+        QMetaObject::invokeMethod(this, [this] { emergencyStop(); }, Qt::BlockingQueuedConnection);
+        return;
+    }
     m_safety.triggerEmergencyStop("User-initiated emergency stop");
 }
 
 void ChargeModule::resetModule()
 {
-    if (!m_can || !m_can->isOpen()) return;
+    if (!isOnModuleThread()) {
+        QMetaObject::invokeMethod(this, [this] { resetModule(); }, Qt::BlockingQueuedConnection);
+        return;
+    }
 
     // Module reset: CAN ID 0x667, standard frame, payload [0xFF, 0x00]
     CanFrame frame;
@@ -241,6 +409,8 @@ void ChargeModule::resetModule()
     frame.data[0] = 0xFF;
     frame.data[1] = 0x00;
     frame.timestamp = std::chrono::steady_clock::now();
+    QMutexLocker lock(&m_mutex);
+    if (!m_can || !m_can->isOpen()) return;
     sendFrame(frame);
     qDebug() << "ChargeModule: Reset command sent (0x667)";
 }
@@ -249,362 +419,658 @@ void ChargeModule::resetModule()
 
 void ChargeModule::onFrameReceived(const CanFrame& frame)
 {
-    emit rawFrameReceived(frame);
-    m_safety.messageReceived(frame.id);
-
-    switch (frame.id) {
-        case canid::ChargeInfo:            decodeChargeInfo(frame); break;
-        case canid::EVSEDCMaxLimits:       decodeEvseMaxLimits(frame); break;
-        case canid::EVSEDCRegulationLimits: decodeEvseRegulationLimits(frame); break;
-        case canid::EVSEDCStatus:          decodeEvseDCStatus(frame); break;
-        case canid::ErrorCodes:            decodeErrorCodes(frame); break;
-        case canid::SoftwareInfo:          decodeSoftwareInfo(frame); break;
-        case canid::SLACInfo:              decodeSLACInfo(frame); break;
-        default: break;
-    }
-}
-
-void ChargeModule::decodeChargeInfo(const CanFrame& frame)
-{
-    // ChargeInfo (0x0600) - use codec for precise decoding
-    auto decoded = m_codec.decode(frame);
-    for (const auto& sig : decoded.decodedSignals) {
-        if (sig.name == "StateMachineState") {
-            auto newState = static_cast<CmsState>(static_cast<uint8_t>(sig.rawValue));
-            if (newState != m_evseData.stateMachineState) {
-                m_evseData.stateMachineState = newState;
-                if (newState != m_lastState) {
-                    m_lastState = newState;
-                    emit stateChanged(newState);
-                }
-            }
-        }
-        else if (sig.name == "AliveCounter") {
-            m_evseData.aliveCounter = static_cast<uint8_t>(sig.rawValue);
-            m_safety.updateAliveCounter(m_evseData.aliveCounter);
-        }
-        else if (sig.name == "ControlPilotState") {
-            m_evseData.controlPilotState = static_cast<ControlPilotState>(sig.rawValue);
-        }
-        else if (sig.name == "ControlPilotDutyCycle") {
-            m_evseData.controlPilotDutyCycle = static_cast<uint8_t>(sig.rawValue);
-        }
-        else if (sig.name == "ActualChargeProtocol") {
-            m_evseData.actualChargeProtocol = static_cast<ChargeProtocol>(sig.rawValue);
-        }
-        else if (sig.name == "ProximityPinState") {
-            m_evseData.proximityPinState = static_cast<uint8_t>(sig.rawValue);
-        }
-        else if (sig.name == "SwS2Close") {
-            m_evseData.swS2Close = (sig.rawValue == 1);
-        }
-        else if (sig.name == "VoltageMatch") {
-            m_evseData.voltageMatch = (sig.rawValue == 1);
-        }
-        else if (sig.name == "EVSECompatible") {
-            m_evseData.evseCompatible = (sig.rawValue == 1);
-        }
-        else if (sig.name == "TCPStatus") {
-            m_evseData.tcpConnected = (sig.rawValue == 1);
-        }
-        else if (sig.name == "BCBStatus") {
-            m_evseData.bcbStatus = static_cast<uint8_t>(sig.rawValue);
-        }
+    if (!m_latencyTrace.isEnabled()) {
+        receiveFrame(frame);
+        return;
+    }
+
+    using Stage = LatencyTrace::Stage;
+    m_rxStamps = {};
+    m_rxStamps.ticks[static_cast<size_t>(Stage::DriverReceive)] = frame.rxTicks;
+    m_rxStamps.mark(Stage::Dequeued);
+    m_rxTrace = &m_rxStamps;
+    receiveFrame(frame);
+    m_rxTrace = nullptr;
+
+    // Reactions recorded their own paths; this one covers decoding
+    if (m_rxStamps.ticks[static_cast<size_t>(Stage::Decoded)]) {
+        m_latencyTrace.record(LatencyTrace::Path::RxDecode, m_rxStamps, Stage::Decided);
     }
-    emit evseDataUpdated();
 }
 
-void ChargeModule::decodeEvseMaxLimits(const CanFrame& frame)
+ChargeModule::RxMessage ChargeModule::rxMessageFor(uint32_t canId)
 {
-    auto decoded = m_codec.decode(frame);
-    for (const auto& sig : decoded.decodedSignals) {
-        if (!sig.isValid) continue;
-        if (sig.name == "EVSEMaxCurrent") m_evseData.evseMaxCurrent = sig.physicalValue;
-        else if (sig.name == "EVSEMaxVoltage") m_evseData.evseMaxVoltage = sig.physicalValue;
-        else if (sig.name == "EVSEMaxPower") m_evseData.evseMaxPower = sig.physicalValue;
-        else if (sig.name == "EVSEEnergyToBeDelivered") m_evseData.evseEnergyToBeDelivered = sig.physicalValue;
+    switch (canId) {
+        case canid::ChargeInfo:            return RxMessage::ChargeInfo;
+        case canid::EVSEDCMaxLimits:       return RxMessage::EvseDCMaxLimits;
+        case canid::EVSEDCRegulationLimits: return RxMessage::EvseDCRegulationLimits;
+        case canid::EVSEDCStatus:          return RxMessage::EvseDCStatus;
+        case canid::ErrorCodes:            return RxMessage::ErrorCodes;
+        case canid::SoftwareInfo:          return RxMessage::SoftwareInfo;
+        case canid::SLACInfo:              return RxMessage::SlacInfo;
+        default:                           return RxMessage::Count;
     }
-    emit evseDataUpdated();
 }
 
-void ChargeModule::decodeEvseRegulationLimits(const CanFrame& frame)
+void ChargeModule::receiveFrame(const CanFrame& received)
 {
-    auto decoded = m_codec.decode(frame);
-    for (const auto& sig : decoded.decodedSignals) {
-        if (!sig.isValid) continue;
-        if (sig.name == "EVSEMinCurrent") m_evseData.evseMinCurrent = sig.physicalValue;
-        else if (sig.name == "EVSEMinVoltage") m_evseData.evseMinVoltage = sig.physicalValue;
-        else if (sig.name == "EVSEPeakCurrentRipple") m_evseData.evsePeakCurrentRipple = sig.physicalValue;
-        else if (sig.name == "EVSECurrentRegulationTolerance") m_evseData.evseCurrentRegulationTolerance = sig.physicalValue;
+    // Injected and fleet-posted frames may carry no receive time. Stamp them once here,
+    // so decoder, signal table, field times, timeouts and sequencer all see the same one.
+    CanFrame frame = received;
+    if (frame.timestamp == std::chrono::steady_clock::time_point{}) {
+        frame.timestamp = std::chrono::steady_clock::now();
+    }
+    emit rawFrameReceived(frame);
+
+    const RxMessage message = rxMessageFor(frame.id);
+    const FrameDecoder::Result result = m_decoder.process(frame);
+    m_safety.messageReceived(result.messageIndex, frame.timestamp);
+    switch (result.outcome) {
+        case FrameDecoder::Outcome::Unknown:
+            // An EvseData message the DBC lacks: nothing to decode, but the EVSE checks still run
+            if (message != RxMessage::Count) {
+                decodeRxMessage(message, frame, false);
+            }
+            break;
+
+        case FrameDecoder::Outcome::Repeated:
+            // Most CMS frames repeat the same payload every cycle. A repeat changes no
+            // value, so the timeout bookkeeping and timestamps are all it needs —
+            // except that the EVSE emergency check must keep firing while the EVSE reports it.
+            if (message != RxMessage::Count) {
+                touchRxFields(message, frame.timestamp);
+            }
+            if (message == RxMessage::EvseDCStatus) {
+                checkEvseStatus();
+            }
+            // Charging may have been requested since VoltageMatch came, which no
+            // ChargeInfo change will report
+            if (message == RxMessage::ChargeInfo && m_evseData.stateMachineState == CmsState::PreCharge) {
+                runSequencer(frame.timestamp);
+            }
+            break;
+
+        case FrameDecoder::Outcome::Decoded:
+            if (message != RxMessage::Count) {
+                decodeRxMessage(message, frame, true);
+            }
+            break;
     }
-    emit evseDataUpdated();
 }
 
-void ChargeModule::decodeEvseDCStatus(const CanFrame& frame)
+void ChargeModule::buildRxTables()
 {
-    auto decoded = m_codec.decode(frame);
-    for (const auto& sig : decoded.decodedSignals) {
-        if (sig.name == "EVSEPresentVoltage" && sig.isValid)
-            m_evseData.evsePresentVoltage = sig.physicalValue;
-        else if (sig.name == "EVSEPresentCurrent" && sig.isValid)
-            m_evseData.evsePresentCurrent = sig.physicalValue;
-        else if (sig.name == "EVSEIsolationStatus")
-            m_evseData.evseIsolationStatus = static_cast<EvseIsolationStatus>(sig.rawValue);
-        else if (sig.name == "EVSEStatusCode")
-            m_evseData.evseStatusCode = static_cast<EvseStatusCode>(sig.rawValue);
-        else if (sig.name == "EVSENotification")
-            m_evseData.evseNotification = static_cast<uint8_t>(sig.rawValue);
-        else if (sig.name == "EVSENotificationMaxDelay")
-            m_evseData.evseNotificationMaxDelay = static_cast<uint16_t>(sig.rawValue);
-        else if (sig.name == "EVSECurrentLimitAchieved")
-            m_evseData.evseCurrentLimitAchieved = (sig.rawValue == 1);
-        else if (sig.name == "EVSEVoltageLimitAchieved")
-            m_evseData.evseVoltageLimitAchieved = (sig.rawValue == 1);
-        else if (sig.name == "EVSEPowerLimitAchieved")
-            m_evseData.evsePowerLimitAchieved = (sig.rawValue == 1);
+    struct BindingSpec {
+        RxMessage message;
+        const char* signal;
+        EvseField field;
+        bool requireValid;
+        RxSetter apply;
+    };
+    using M = ChargeModule;
+    using F = EvseField;
+    static const BindingSpec specs[] = {
+        // ChargeInfo (0x0600)
+        {RxMessage::ChargeInfo, "StateMachineState", F::StateMachineState, false, [](M& m, uint64_t raw, double) {
+            auto newState = static_cast<CmsState>(static_cast<uint8_t>(raw));
+            if (!assign(m.m_evseData.stateMachineState, newState)) return false;
+            if (newState != m.m_lastState) {
+                m.m_lastState = newState;
+                emit m.stateChanged(newState);
+            }
+            return true;
+        }},
+        {RxMessage::ChargeInfo, "AliveCounter", F::AliveCounter, false, [](M& m, uint64_t raw, double) {
+            bool changed = assign(m.m_evseData.aliveCounter, static_cast<uint8_t>(raw));
+            m.m_safety.updateAliveCounter(m.m_evseData.aliveCounter);
+            return changed;
+        }},
+        {RxMessage::ChargeInfo, "ControlPilotState", F::ControlPilotState, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.controlPilotState, static_cast<ControlPilotState>(raw));
+        }},
+        {RxMessage::ChargeInfo, "ControlPilotDutyCycle", F::ControlPilotDutyCycle, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.controlPilotDutyCycle, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::ChargeInfo, "ActualChargeProtocol", F::ActualChargeProtocol, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.actualChargeProtocol, static_cast<ChargeProtocol>(raw));
+        }},
+        {RxMessage::ChargeInfo, "ProximityPinState", F::ProximityPinState, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.proximityPinState, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::ChargeInfo, "SwS2Close", F::SwS2Close, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.swS2Close, raw == 1);
+        }},
+        {RxMessage::ChargeInfo, "VoltageMatch", F::VoltageMatch, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.voltageMatch, raw == 1);
+        }},
+        {RxMessage::ChargeInfo, "EVSECompatible", F::EvseCompatible, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evseCompatible, raw == 1);
+        }},
+        {RxMessage::ChargeInfo, "TCPStatus", F::TcpConnected, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.tcpConnected, raw == 1);
+        }},
+        {RxMessage::ChargeInfo, "BCBStatus", F::BcbStatus, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.bcbStatus, static_cast<uint8_t>(raw));
+        }},
+
+        // EVSEDCMaxLimits (0x1400)
+        {RxMessage::EvseDCMaxLimits, "EVSEMaxCurrent", F::EvseMaxCurrent, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evseMaxCurrent, phys);
+        }},
+        {RxMessage::EvseDCMaxLimits, "EVSEMaxVoltage", F::EvseMaxVoltage, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evseMaxVoltage, phys);
+        }},
+        {RxMessage::EvseDCMaxLimits, "EVSEMaxPower", F::EvseMaxPower, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evseMaxPower, phys);
+        }},
+        {RxMessage::EvseDCMaxLimits, "EVSEEnergyToBeDelivered", F::EvseEnergyToBeDelivered, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evseEnergyToBeDelivered, phys);
+        }},
+
+        // EVSEDCRegulationLimits (0x1401)
+        {RxMessage::EvseDCRegulationLimits, "EVSEMinCurrent", F::EvseMinCurrent, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evseMinCurrent, phys);
+        }},
+        {RxMessage::EvseDCRegulationLimits, "EVSEMinVoltage", F::EvseMinVoltage, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evseMinVoltage, phys);
+        }},
+        {RxMessage::EvseDCRegulationLimits, "EVSEPeakCurrentRipple", F::EvsePeakCurrentRipple, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evsePeakCurrentRipple, phys);
+        }},
+        {RxMessage::EvseDCRegulationLimits, "EVSECurrentRegulationTolerance", F::EvseCurrentRegulationTolerance, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evseCurrentRegulationTolerance, phys);
+        }},
+
+        // EVSEDCStatus (0x1402)
+        {RxMessage::EvseDCStatus, "EVSEPresentVoltage", F::EvsePresentVoltage, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evsePresentVoltage, phys);
+        }},
+        {RxMessage::EvseDCStatus, "EVSEPresentCurrent", F::EvsePresentCurrent, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.evsePresentCurrent, phys);
+        }},
+        {RxMessage::EvseDCStatus, "EVSEIsolationStatus", F::EvseIsolationStatus, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evseIsolationStatus, static_cast<EvseIsolationStatus>(raw));
+        }},
+        {RxMessage::EvseDCStatus, "EVSEStatusCode", F::EvseStatusCode, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evseStatusCode, static_cast<EvseStatusCode>(raw));
+        }},
+        {RxMessage::EvseDCStatus, "EVSENotification", F::EvseNotification, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evseNotification, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::EvseDCStatus, "EVSENotificationMaxDelay", F::EvseNotificationMaxDelay, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evseNotificationMaxDelay, static_cast<uint16_t>(raw));
+        }},
+        {RxMessage::EvseDCStatus, "EVSECurrentLimitAchieved", F::EvseCurrentLimitAchieved, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evseCurrentLimitAchieved, raw == 1);
+        }},
+        {RxMessage::EvseDCStatus, "EVSEVoltageLimitAchieved", F::EvseVoltageLimitAchieved, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evseVoltageLimitAchieved, raw == 1);
+        }},
+        {RxMessage::EvseDCStatus, "EVSEPowerLimitAchieved", F::EvsePowerLimitAchieved, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.evsePowerLimitAchieved, raw == 1);
+        }},
+
+        // ErrorCodes (0x2002)
+        {RxMessage::ErrorCodes, "ErrorCodeLevel0", F::ErrorCode0, false, [](M& m, uint64_t raw, double) {
+            auto code = static_cast<uint16_t>(raw);
+            if (code != m.m_evseData.errorCode0 && code > 1) {
+                emit m.errorCodeReceived(code, SafetyMonitor::errorCodeDescription(code));
+            }
+            return assign(m.m_evseData.errorCode0, code);
+        }},
+        {RxMessage::ErrorCodes, "ErrorCodeLevel1", F::ErrorCode1, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.errorCode1, static_cast<uint16_t>(raw));
+        }},
+        {RxMessage::ErrorCodes, "ErrorCodeLevel2", F::ErrorCode2, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.errorCode2, static_cast<uint16_t>(raw));
+        }},
+        {RxMessage::ErrorCodes, "ErrorCodeLevel3", F::ErrorCode3, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.errorCode3, static_cast<uint16_t>(raw));
+        }},
+
+        // SoftwareInfo (0x2001)
+        {RxMessage::SoftwareInfo, "SoftwareVersionMajor", F::SwVersionMajor, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.swVersionMajor, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::SoftwareInfo, "SoftwareVersionMinor", F::SwVersionMinor, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.swVersionMinor, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::SoftwareInfo, "SoftwareVersionPatch", F::SwVersionPatch, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.swVersionPatch, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::SoftwareInfo, "SoftwareVersionConfig", F::SwVersionConfig, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.swVersionConfig, static_cast<uint8_t>(raw));
+        }},
+
+        // SLACInfo (0x2003)
+        {RxMessage::SlacInfo, "SLACState", F::SlacState, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.slacState, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::SlacInfo, "LinkStatus", F::LinkStatus, false, [](M& m, uint64_t raw, double) {
+            return assign(m.m_evseData.linkStatus, static_cast<uint8_t>(raw));
+        }},
+        {RxMessage::SlacInfo, "MeasuredAttenuation", F::MeasuredAttenuation, true, [](M& m, uint64_t, double phys) {
+            return assign(m.m_evseData.measuredAttenuation, phys);
+        }},
+    };
+    static constexpr uint32_t messageIds[] = {
+        canid::ChargeInfo, canid::EVSEDCMaxLimits, canid::EVSEDCRegulationLimits,
+        canid::EVSEDCStatus, canid::ErrorCodes, canid::SoftwareInfo, canid::SLACInfo,
+    };
+
+    for (auto& table : m_rxTables) table.clear();
+
+    std::array<bool, static_cast<size_t>(RxMessage::Count)> messageMissing{};
+    for (const auto& spec : specs) {
+        size_t index = static_cast<size_t>(spec.message);
+        uint32_t canId = messageIds[index];
+        if (messageMissing[index]) continue;
+        if (!m_dbc.findMessage(canId)) {
+            messageMissing[index] = true;
+            m_bindingWarnings.append(QString("RX message 0x%1 not found")
+                .arg(canId, 4, 16, QChar('0')));
+            continue;
+        }
+        int handle = m_dbc.signalHandle(canId, QString::fromLatin1(spec.signal));
+        if (handle < 0) {
+            m_bindingWarnings.append(QString("RX signal %1 not found in message 0x%2")
+                .arg(spec.signal).arg(canId, 4, 16, QChar('0')));
+            continue;
+        }
+        m_rxTables[static_cast<size_t>(spec.message)].append({handle, spec.requireValid, spec.field, spec.apply});
     }
 
-    // Safety: react to EVSE emergency/malfunction
-    if (m_evseData.evseStatusCode == EvseStatusCode::EmergencyShutdown ||
-        m_evseData.evseStatusCode == EvseStatusCode::Malfunction) {
-        m_safety.triggerEmergencyStop("EVSE emergency/malfunction detected");
+    // Apply in DBC signal order, as the frame lays them out
+    for (auto& table : m_rxTables) {
+        std::sort(table.begin(), table.end(),
+                  [](const RxBinding& a, const RxBinding& b) { return a.handle < b.handle; });
     }
+}
 
-    emit evseDataUpdated();
+void ChargeModule::buildTimeoutMonitors()
+{
+    // Monitors follow the decoder's layout order, so a frame re-arms its deadline by index
+    QVector<SafetyMonitor::MonitoredMessage> monitored;
+    for (const auto& msg : m_decoder.layout().messages()) {
+        SafetyMonitor::MonitoredMessage entry;
+        entry.canId = msg.canId;
+        entry.name = QString::fromStdString(msg.name);
+        entry.cycleTimeMs = msg.cycleTimeMs;
+        for (const auto& image : m_txImages) {
+            if (image.frame.id == msg.canId) entry.cycleTimeMs = 0; // sent by this side
+        }
+        monitored.append(entry);
+    }
+    m_safety.setMonitoredMessages(monitored);
 }
 
-void ChargeModule::decodeErrorCodes(const CanFrame& frame)
+void ChargeModule::decodeRxMessage(RxMessage message, const CanFrame& frame, bool decoded)
 {
-    auto decoded = m_codec.decode(frame);
-    for (const auto& sig : decoded.decodedSignals) {
-        uint16_t code = static_cast<uint16_t>(sig.rawValue);
-        if (sig.name == "ErrorCodeLevel0") {
-            if (code != m_evseData.errorCode0 && code > 1) {
-                emit errorCodeReceived(code, SafetyMonitor::errorCodeDescription(code));
+    EvseFieldMask changed = 0;
+    if (decoded) {
+        const SignalValues& values = m_decoder.values();
+        const int64_t timeNs = toNanoseconds(frame.timestamp);
+        for (const auto& binding : m_rxTables[static_cast<size_t>(message)]) {
+            if (binding.requireValid && !values.valid[binding.handle]) continue;
+            if (binding.apply(*this, values.raw[binding.handle], values.physical[binding.handle])) {
+                changed |= fieldBit(binding.field);
             }
-            m_evseData.errorCode0 = code;
+            m_evseFieldTimeNs[static_cast<size_t>(binding.field)].store(timeNs, std::memory_order_relaxed);
         }
-        else if (sig.name == "ErrorCodeLevel1") m_evseData.errorCode1 = code;
-        else if (sig.name == "ErrorCodeLevel2") m_evseData.errorCode2 = code;
-        else if (sig.name == "ErrorCodeLevel3") m_evseData.errorCode3 = code;
     }
-    emit evseDataUpdated();
+    stamp(LatencyTrace::Stage::Decoded);
+
+    if (message == RxMessage::EvseDCStatus) {
+        checkEvseStatus();
+    }
+
+    // React before anything is published: the sequencer's sends are time-critical
+    constexpr EvseFieldMask sequencerInputs = fieldBit(EvseField::StateMachineState)
+                                            | fieldBit(EvseField::VoltageMatch);
+    if (message == RxMessage::ChargeInfo
+        && ((changed & sequencerInputs) || m_evseData.stateMachineState == CmsState::PreCharge)) {
+        runSequencer(frame.timestamp);
+    }
+
+    if (changed) {
+        m_evseSnapshot.store(m_evseData);
+        noteEvseChanges(changed);
+    }
 }
 
-void ChargeModule::decodeSoftwareInfo(const CanFrame& frame)
+void ChargeModule::touchRxFields(RxMessage message, Clock::time_point timestamp)
 {
-    auto decoded = m_codec.decode(frame);
-    for (const auto& sig : decoded.decodedSignals) {
-        if (sig.name == "SoftwareVersionMajor") m_evseData.swVersionMajor = static_cast<uint8_t>(sig.rawValue);
-        else if (sig.name == "SoftwareVersionMinor") m_evseData.swVersionMinor = static_cast<uint8_t>(sig.rawValue);
-        else if (sig.name == "SoftwareVersionPatch") m_evseData.swVersionPatch = static_cast<uint8_t>(sig.rawValue);
-        else if (sig.name == "SoftwareVersionConfig") m_evseData.swVersionConfig = static_cast<uint8_t>(sig.rawValue);
+    // The decoder still holds this message's last decode, SNA flags included
+    const SignalValues& values = m_decoder.values();
+    const int64_t timeNs = toNanoseconds(timestamp);
+    for (const auto& binding : m_rxTables[static_cast<size_t>(message)]) {
+        if (binding.requireValid && !values.valid[binding.handle]) continue;
+        m_evseFieldTimeNs[static_cast<size_t>(binding.field)].store(timeNs, std::memory_order_relaxed);
     }
-    emit evseDataUpdated();
 }
 
-void ChargeModule::decodeSLACInfo(const CanFrame& frame)
+ChargeModule::Clock::duration ChargeModule::age(EvseField field, Clock::time_point now) const
 {
-    auto decoded = m_codec.decode(frame);
-    for (const auto& sig : decoded.decodedSignals) {
-        if (sig.name == "SLACState") m_evseData.slacState = static_cast<uint8_t>(sig.rawValue);
-        else if (sig.name == "LinkStatus") m_evseData.linkStatus = static_cast<uint8_t>(sig.rawValue);
-        else if (sig.name == "MeasuredAttenuation" && sig.isValid) m_evseData.measuredAttenuation = sig.physicalValue;
+    if (field >= EvseField::Count) return Clock::duration::max();
+    const int64_t timeNs = m_evseFieldTimeNs[static_cast<size_t>(field)].load(std::memory_order_relaxed);
+    if (timeNs == 0) return Clock::duration::max();
+    return now - Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(timeNs)));
+}
+
+ChargeModule::EvseFieldMask ChargeModule::staleFields(EvseFieldMask fields, Clock::duration maxAge,
+                                                      Clock::time_point now) const
+{
+    EvseFieldMask stale = 0;
+    for (EvseFieldMask rest = fields; rest != 0; rest &= rest - 1) {
+        const auto field = static_cast<EvseField>(std::countr_zero(rest));
+        if (!isFresh(field, maxAge, now)) stale |= fieldBit(field);
     }
-    emit evseDataUpdated();
+    return stale;
 }
 
-// ─── Cyclic TX ───────────────────────────────────────────
+void ChargeModule::noteEvseChanges(EvseFieldMask changed)
+{
+    m_pendingChanges |= changed;
+    // Quiet until now: report at once. Inside a rate window the bits wait for its end.
+    auto now = std::chrono::steady_clock::now();
+    if (m_notifyIntervalMs <= 0 || now >= m_notifyWindowEnd) {
+        flushEvseChanges(now);
+    }
+}
+
+void ChargeModule::flushEvseChanges(std::chrono::steady_clock::time_point now)
+{
+    // Also the end of a rate window: with nothing pending the window just closes
+    if (m_pendingChanges == 0) return;
+    emit evseDataChanged(std::exchange(m_pendingChanges, 0));
+    const int intervalMs = m_notifyIntervalMs;
+    m_notifyWindowEnd = now + std::chrono::milliseconds(intervalMs);
+    if (m_notifyTimer && intervalMs > 0) {
+        m_notifyTimer->start(intervalMs);
+    }
+}
 
-void ChargeModule::onCyclicTx()
+void ChargeModule::checkEvseStatus()
 {
-    if (!m_can || !m_can->isOpen() || !m_running) return;
+    // Safety: react to EVSE emergency/malfunction
+    const bool emergency = m_evseData.evseStatusCode == EvseStatusCode::EmergencyShutdown ||
+                           m_evseData.evseStatusCode == EvseStatusCode::Malfunction;
+    stamp(LatencyTrace::Stage::Decided);
+    if (emergency) {
+        m_safety.triggerEmergencyStop("EVSE emergency/malfunction detected");
+    }
+}
 
+void ChargeModule::runSequencer(std::chrono::steady_clock::time_point rxTime)
+{
     QMutexLocker lock(&m_mutex);
+    m_paramState = m_evseData.stateMachineState;
+    drainCommands(); // decide on the parameters as last set
+    const bool requested = m_evParams.evReady && m_evParams.chargeStop == ChargeStopIndication::NoStop;
+    const bool startSent = m_evParams.chargeProgress == ChargeProgressIndication::Start;
+    const auto actions = m_sequencer.onChargeInfo(m_evseData.stateMachineState, m_evseData.voltageMatch,
+                                                  requested, startSent, rxTime);
+    if (actions == ChargeSequencer::NoAction) return;
+
+    // The limit is a parameter, so it holds while stopped too: the sequencer reports
+    // entering PreCharge only once, and a later start() must not send the old target
+    if (actions & ChargeSequencer::LimitPreChargeCurrent) {
+        m_evParams.evTargetCurrent = ChargeSequencer::PreChargeCurrentA;
+        markDirty(TxField::EvTargetCurrent);
+    }
+    // Stopped or emergency stopped: only the safe state may go out
+    if (!m_running || m_safety.isEmergencyStopped()) {
+        if (actions & ChargeSequencer::LimitPreChargeCurrent) publishEvParams();
+        return;
+    }
+    stamp(LatencyTrace::Stage::Decided);
 
-    // If emergency stopped, only send safe state
-    if (m_safety.isEmergencyStopped()) {
-        m_evParams.evReady = false;
-        m_evParams.chargeProgress = ChargeProgressIndication::Stop;
-        m_evParams.chargeStop = ChargeStopIndication::Terminate;
+    if (actions & ChargeSequencer::StartCharge) {
+        m_evParams.chargeProgress = ChargeProgressIndication::Start;
+        markDirty(TxField::ChargeProgress);
     }
+    publishEvParams();
 
-    // Send all VCU → CMS messages at 100ms cycle per DBC
-    sendEvDCMaxLimits();
-    sendEvDCChargeTargets();
-    sendEvStatusControl();
-    sendEvStatusDisplay();
-    sendEvPlugStatus();
-    sendEvDCEnergyLimits();
+    // Out of cycle: the CMS sees the change now, not at the message's next TX slot
+    if (!m_can || !m_can->isOpen()) return;
+    if (actions & ChargeSequencer::LimitPreChargeCurrent) {
+        sendTxMessage(TxMessage::EvDCChargeTargets, m_rxTrace);
+    }
+    if (actions & ChargeSequencer::StartCharge) {
+        sendTxMessage(TxMessage::EvStatusControl, m_rxTrace);
+    }
+    const auto sentTime = std::chrono::steady_clock::now();
+    lock.unlock();
+    if (m_rxTrace) {
+        m_latencyTrace.record(LatencyTrace::Path::Sequencer, *m_rxTrace);
+    }
+    m_sequencer.noteReaction(actions, rxTime, sentTime);
 }
 
-void ChargeModule::sendEvDCMaxLimits()
+// ─── Cyclic TX ───────────────────────────────────────────
+
+QVector<TxScheduler::Entry> ChargeModule::txSchedule() const
 {
-    // EVDCMaxLimits (0x1300): EVMaxCurrent, EVMaxVoltage, EVMaxPower, EVFullSoC, EVBulkSoC
-    CanFrame frame;
-    frame.id = canid::EVDCMaxLimits;
-    frame.extended = true;
-    frame.dlc = 8;
-    frame.timestamp = std::chrono::steady_clock::now();
-    std::memset(frame.data.data(), 0, 8);
-
-    const auto* msg = m_dbc.findMessage(canid::EVDCMaxLimits);
-    if (msg) {
-        for (const auto& sig : msg->dbcSignals) {
-            if (sig.name == "EVMaxCurrent")
-                m_codec.encodeSignal(frame, sig, m_evParams.evMaxCurrent);
-            else if (sig.name == "EVMaxVoltage")
-                m_codec.encodeSignal(frame, sig, m_evParams.evMaxVoltage);
-            else if (sig.name == "EVMaxPower")
-                m_codec.encodeSignal(frame, sig, m_evParams.evMaxPower);
-            else if (sig.name == "EVFullSoC")
-                m_codec.encodeSignal(frame, sig, m_evParams.evFullSoC);
-            else if (sig.name == "EVBulkSoC")
-                m_codec.encodeSignal(frame, sig, m_evParams.evBulkSoC);
-        }
+    // Period and phase per message from GenMsgCycleTime / GenMsgStartDelayTime.
+    // Without a start delay the messages are spread evenly over their period,
+    // so the bus never sees all six in one burst.
+    QVector<TxScheduler::Entry> entries;
+    const int count = static_cast<int>(m_txImages.size());
+    for (int i = 0; i < count; ++i) {
+        const auto* msg = m_dbc.findMessage(m_txImages[i].frame.id);
+        TxScheduler::Entry entry;
+        entry.periodMs = (msg && msg->cycleTimeMs > 0) ? msg->cycleTimeMs : DefaultTxCycleMs;
+        entry.phaseMs = (msg && msg->startDelayMs > 0) ? msg->startDelayMs : i * entry.periodMs / count;
+        entries.append(entry);
     }
-
-    sendFrame(frame);
+    return entries;
 }
 
-void ChargeModule::sendEvDCChargeTargets()
+void ChargeModule::serviceTx(int entry)
 {
-    CanFrame frame;
-    frame.id = canid::EVDCChargeTargets;
-    frame.extended = true;
-    frame.dlc = 8;
-    frame.timestamp = std::chrono::steady_clock::now();
-    std::memset(frame.data.data(), 0, 8);
-
-    const auto* msg = m_dbc.findMessage(canid::EVDCChargeTargets);
-    if (msg) {
-        for (const auto& sig : msg->dbcSignals) {
-            if (sig.name == "EVTargetCurrent")
-                m_codec.encodeSignal(frame, sig, m_evParams.evTargetCurrent);
-            else if (sig.name == "EVTargetVoltage")
-                m_codec.encodeSignal(frame, sig, m_evParams.evTargetVoltage);
-            else if (sig.name == "EVPreChargeVoltage")
-                m_codec.encodeSignal(frame, sig, m_evParams.evPreChargeVoltage);
-        }
+    if (entry >= 0 && entry < static_cast<int>(TxMessage::Count)) {
+        onTxDue(static_cast<TxMessage>(entry));
     }
+}
 
-    sendFrame(frame);
+void ChargeModule::serviceTimers()
+{
+    m_safety.checkTimeouts();
+
+    auto now = std::chrono::steady_clock::now();
+    if (m_pendingChanges != 0 && now >= m_notifyWindowEnd) {
+        flushEvseChanges(now);
+    }
 }
 
-void ChargeModule::sendEvStatusControl()
+void ChargeModule::onTxDue(TxMessage message)
 {
-    CanFrame frame;
-    frame.id = canid::EVStatusControl;
-    frame.extended = true;
-    frame.dlc = 8;
-    frame.timestamp = std::chrono::steady_clock::now();
-    std::memset(frame.data.data(), 0, 8);
-
-    const auto* msg = m_dbc.findMessage(canid::EVStatusControl);
-    if (msg) {
-        for (const auto& sig : msg->dbcSignals) {
-            if (sig.name == "ChargeProgressIndication")
-                m_codec.encodeSignalRaw(frame, sig, static_cast<uint64_t>(m_evParams.chargeProgress));
-            else if (sig.name == "ChargeStopIndication")
-                m_codec.encodeSignalRaw(frame, sig, static_cast<uint64_t>(m_evParams.chargeStop));
-            else if (sig.name == "EVReady")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evReady ? 1ULL : 0ULL);
-            else if (sig.name == "EVWeldingDetectionEnable")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evWeldingDetectionEnable ? 1ULL : 0ULL);
-            else if (sig.name == "ChargeProtocolPriority")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.chargeProtocolPriority);
-            else if (sig.name == "BCBControl")
-                m_codec.encodeSignalRaw(frame, sig, static_cast<uint64_t>(m_evParams.bcbControl));
-        }
+    // Runs on the scheduler thread, or a pool worker for a Pooled module
+    QMutexLocker lock(&m_mutex);
+    // Checked under the lock, so no cyclic frame follows the safe state sent by stop(),
+    // and setCanInterface() cannot swap the interface under us
+    if (!m_running || !m_can || !m_can->isOpen()) return;
+    drainCommands();
+
+    // If emergency stopped, only send safe state
+    if (m_safety.isEmergencyStopped()) {
+        applySafeState();
     }
 
-    sendFrame(frame);
+    sendTxMessage(message);
 }
 
-void ChargeModule::sendEvStatusDisplay()
+void ChargeModule::applySafeState()
 {
-    CanFrame frame;
-    frame.id = canid::EVStatusDisplay;
-    frame.extended = true;
-    frame.dlc = 8;
-    frame.timestamp = std::chrono::steady_clock::now();
-    std::memset(frame.data.data(), 0, 8);
-
-    const auto* msg = m_dbc.findMessage(canid::EVStatusDisplay);
-    if (msg) {
-        for (const auto& sig : msg->dbcSignals) {
-            if (sig.name == "EVSoC")
-                m_codec.encodeSignal(frame, sig, m_evParams.evSoC);
-            else if (sig.name == "EVErrorCode")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evErrorCode);
-            else if (sig.name == "EVChargingComplete")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evChargingComplete ? 1ULL : 0ULL);
-            else if (sig.name == "EVBulkChargingComplete")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evBulkChargingComplete ? 1ULL : 0ULL);
-            else if (sig.name == "EVCabinConditioning")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evCabinConditioning ? 1ULL : 0ULL);
-            else if (sig.name == "EVRESSConditioning")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evRessConditioning ? 1ULL : 0ULL);
-            else if (sig.name == "EVTimeToFullSoC")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evTimeToFullSoC);
-            else if (sig.name == "EVTimeToBulkSoC")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evTimeToBulkSoC);
-        }
+    m_evParams.evReady = false;
+    m_evParams.chargeProgress = ChargeProgressIndication::Stop;
+    m_evParams.chargeStop = ChargeStopIndication::Terminate;
+    markDirty(TxField::EvReady);
+    markDirty(TxField::ChargeProgress);
+    markDirty(TxField::ChargeStop);
+    publishEvParams();
+}
+
+void ChargeModule::buildTxImages()
+{
+    struct BindingSpec {
+        TxMessage message;
+        const char* signal;
+        TxField field;
+    };
+    static const BindingSpec specs[] = {
+        // EVDCMaxLimits (0x1300)
+        {TxMessage::EvDCMaxLimits, "EVMaxCurrent", TxField::EvMaxCurrent},
+        {TxMessage::EvDCMaxLimits, "EVMaxVoltage", TxField::EvMaxVoltage},
+        {TxMessage::EvDCMaxLimits, "EVMaxPower", TxField::EvMaxPower},
+        {TxMessage::EvDCMaxLimits, "EVFullSoC", TxField::EvFullSoC},
+        {TxMessage::EvDCMaxLimits, "EVBulkSoC", TxField::EvBulkSoC},
+        // EVDCChargeTargets (0x1301)
+        {TxMessage::EvDCChargeTargets, "EVTargetCurrent", TxField::EvTargetCurrent},
+        {TxMessage::EvDCChargeTargets, "EVTargetVoltage", TxField::EvTargetVoltage},
+        {TxMessage::EvDCChargeTargets, "EVPreChargeVoltage", TxField::EvPreChargeVoltage},
+        // EVStatusControl (0x1302)
+        {TxMessage::EvStatusControl, "ChargeProgressIndication", TxField::ChargeProgress},
+        {TxMessage::EvStatusControl, "ChargeStopIndication", TxField::ChargeStop},
+        {TxMessage::EvStatusControl, "EVReady", TxField::EvReady},
+        {TxMessage::EvStatusControl, "EVWeldingDetectionEnable", TxField::EvWeldingDetectionEnable},
+        {TxMessage::EvStatusControl, "ChargeProtocolPriority", TxField::ChargeProtocolPriority},
+        {TxMessage::EvStatusControl, "BCBControl", TxField::BcbControl},
+        // EVStatusDisplay (0x1303)
+        {TxMessage::EvStatusDisplay, "EVSoC", TxField::EvSoC},
+        {TxMessage::EvStatusDisplay, "EVErrorCode", TxField::EvErrorCode},
+        {TxMessage::EvStatusDisplay, "EVChargingComplete", TxField::EvChargingComplete},
+        {TxMessage::EvStatusDisplay, "EVBulkChargingComplete", TxField::EvBulkChargingComplete},
+        {TxMessage::EvStatusDisplay, "EVCabinConditioning", TxField::EvCabinConditioning},
+        {TxMessage::EvStatusDisplay, "EVRESSConditioning", TxField::EvRessConditioning},
+        {TxMessage::EvStatusDisplay, "EVTimeToFullSoC", TxField::EvTimeToFullSoC},
+        {TxMessage::EvStatusDisplay, "EVTimeToBulkSoC", TxField::EvTimeToBulkSoC},
+        // EVPlugStatus (0x1304)
+        {TxMessage::EvPlugStatus, "EVControlPilotDutyCycle", TxField::EvControlPilotDutyCycle},
+        {TxMessage::EvPlugStatus, "EVControlPilotState", TxField::EvControlPilotState},
+        {TxMessage::EvPlugStatus, "EVProximityPinState", TxField::EvProximityPinState},
+        // EVDCEnergyLimits (0x1305)
+        {TxMessage::EvDCEnergyLimits, "EVEnergyCapacity", TxField::EvEnergyCapacity},
+        {TxMessage::EvDCEnergyLimits, "EVEnergyRequest", TxField::EvEnergyRequest},
+    };
+    static constexpr uint32_t messageIds[] = {
+        canid::EVDCMaxLimits, canid::EVDCChargeTargets, canid::EVStatusControl,
+        canid::EVStatusDisplay, canid::EVPlugStatus, canid::EVDCEnergyLimits,
+    };
+
+    m_txSlots.fill(TxSlot{});
+    for (size_t i = 0; i < m_txImages.size(); ++i) {
+        TxImage& image = m_txImages[i];
+        image.frame = CanFrame{};
+        image.frame.id = messageIds[i];
+        image.frame.extended = true;
+        image.frame.dlc = 8;
+        image.bindings.clear();
+        image.dirty = 0;
     }
 
-    sendFrame(frame);
+    std::array<bool, static_cast<size_t>(TxMessage::Count)> messageMissing{};
+    for (const auto& spec : specs) {
+        int imageIndex = static_cast<int>(spec.message);
+        TxImage& image = m_txImages[imageIndex];
+        const auto* sig = m_dbc.findSignal(image.frame.id, QString::fromLatin1(spec.signal));
+        if (!sig) {
+            // Nothing to report before a DBC is loaded; a missing message is reported once
+            if (!m_dbc.messages.isEmpty() && !messageMissing[imageIndex]) {
+                messageMissing[imageIndex] = !m_dbc.findMessage(image.frame.id);
+                m_bindingWarnings.append(messageMissing[imageIndex]
+                    ? QString("TX message 0x%1 not found").arg(image.frame.id, 4, 16, QChar('0'))
+                    : QString("TX signal %1 not found in message 0x%2")
+                          .arg(spec.signal).arg(image.frame.id, 4, 16, QChar('0')));
+            }
+            continue;
+        }
+
+        uint32_t bit = 1u << image.bindings.size();
+        image.bindings.append({sig, spec.field});
+        image.dirty |= bit;
+        m_txSlots[static_cast<size_t>(spec.field)] = {imageIndex, bit};
+    }
 }
 
-void ChargeModule::sendEvPlugStatus()
+void ChargeModule::markDirty(TxField field)
 {
-    CanFrame frame;
-    frame.id = canid::EVPlugStatus;
-    frame.extended = true;
-    frame.dlc = 8;
-    frame.timestamp = std::chrono::steady_clock::now();
-    std::memset(frame.data.data(), 0, 8);
-
-    const auto* msg = m_dbc.findMessage(canid::EVPlugStatus);
-    if (msg) {
-        for (const auto& sig : msg->dbcSignals) {
-            if (sig.name == "EVControlPilotDutyCycle")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evControlPilotDutyCycle);
-            else if (sig.name == "EVControlPilotState")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evControlPilotState);
-            else if (sig.name == "EVProximityPinState")
-                m_codec.encodeSignalRaw(frame, sig, m_evParams.evProximityPinState);
-        }
+    const TxSlot& slot = m_txSlots[static_cast<size_t>(field)];
+    if (slot.image >= 0) {
+        m_txImages[slot.image].dirty |= slot.bit;
     }
+}
 
-    sendFrame(frame);
+void ChargeModule::encodeTxBinding(CanFrame& frame, const TxBinding& binding) const
+{
+    const DbcSignal& sig = *binding.sig;
+    const auto& p = m_evParams;
+    switch (binding.field) {
+        case TxField::EvMaxCurrent:       m_codec.encodeSignal(frame, sig, p.evMaxCurrent); break;
+        case TxField::EvMaxVoltage:       m_codec.encodeSignal(frame, sig, p.evMaxVoltage); break;
+        case TxField::EvMaxPower:         m_codec.encodeSignal(frame, sig, p.evMaxPower); break;
+        case TxField::EvFullSoC:          m_codec.encodeSignal(frame, sig, p.evFullSoC); break;
+        case TxField::EvBulkSoC:          m_codec.encodeSignal(frame, sig, p.evBulkSoC); break;
+        case TxField::EvTargetCurrent:    m_codec.encodeSignal(frame, sig, p.evTargetCurrent); break;
+        case TxField::EvTargetVoltage:    m_codec.encodeSignal(frame, sig, p.evTargetVoltage); break;
+        case TxField::EvPreChargeVoltage: m_codec.encodeSignal(frame, sig, p.evPreChargeVoltage); break;
+        case TxField::ChargeProgress:
+            m_codec.encodeSignalRaw(frame, sig, static_cast<uint64_t>(p.chargeProgress)); break;
+        case TxField::ChargeStop:
+            m_codec.encodeSignalRaw(frame, sig, static_cast<uint64_t>(p.chargeStop)); break;
+        case TxField::EvReady:
+            m_codec.encodeSignalRaw(frame, sig, p.evReady ? 1ULL : 0ULL); break;
+        case TxField::EvWeldingDetectionEnable:
+            m_codec.encodeSignalRaw(frame, sig, p.evWeldingDetectionEnable ? 1ULL : 0ULL); break;
+        case TxField::ChargeProtocolPriority:
+            m_codec.encodeSignalRaw(frame, sig, p.chargeProtocolPriority); break;
+        case TxField::BcbControl:
+            m_codec.encodeSignalRaw(frame, sig, static_cast<uint64_t>(p.bcbControl)); break;
+        case TxField::EvSoC:              m_codec.encodeSignal(frame, sig, p.evSoC); break;
+        case TxField::EvErrorCode:        m_codec.encodeSignalRaw(frame, sig, p.evErrorCode); break;
+        case TxField::EvChargingComplete:
+            m_codec.encodeSignalRaw(frame, sig, p.evChargingComplete ? 1ULL : 0ULL); break;
+        case TxField::EvBulkChargingComplete:
+            m_codec.encodeSignalRaw(frame, sig, p.evBulkChargingComplete ? 1ULL : 0ULL); break;
+        case TxField::EvCabinConditioning:
+            m_codec.encodeSignalRaw(frame, sig, p.evCabinConditioning ? 1ULL : 0ULL); break;
+        case TxField::EvRessConditioning:
+            m_codec.encodeSignalRaw(frame, sig, p.evRessConditioning ? 1ULL : 0ULL); break;
+        case TxField::EvTimeToFullSoC:    m_codec.encodeSignalRaw(frame, sig, p.evTimeToFullSoC); break;
+        case TxField::EvTimeToBulkSoC:    m_codec.encodeSignalRaw(frame, sig, p.evTimeToBulkSoC); break;
+        case TxField::EvControlPilotDutyCycle:
+            m_codec.encodeSignalRaw(frame, sig, p.evControlPilotDutyCycle); break;
+        case TxField::EvControlPilotState:
+            m_codec.encodeSignalRaw(frame, sig, p.evControlPilotState); break;
+        case TxField::EvProximityPinState:
+            m_codec.encodeSignalRaw(frame, sig, p.evProximityPinState); break;
+        case TxField::EvEnergyCapacity:   m_codec.encodeSignal(frame, sig, p.evEnergyCapacity); break;
+        case TxField::EvEnergyRequest:    m_codec.encodeSignal(frame, sig, p.evEnergyRequest); break;
+        case TxField::Count: break;
+    }
 }
 
-void ChargeModule::sendEvDCEnergyLimits()
+void ChargeModule::sendTxMessage(TxMessage message, LatencyTrace::Stamps* trace)
 {
-    CanFrame frame;
-    frame.id = canid::EVDCEnergyLimits;
-    frame.extended = true;
-    frame.dlc = 8;
-    frame.timestamp = std::chrono::steady_clock::now();
-    std::memset(frame.data.data(), 0, 8);
-
-    const auto* msg = m_dbc.findMessage(canid::EVDCEnergyLimits);
-    if (msg) {
-        for (const auto& sig : msg->dbcSignals) {
-            if (sig.name == "EVEnergyCapacity")
-                m_codec.encodeSignal(frame, sig, m_evParams.evEnergyCapacity);
-            else if (sig.name == "EVEnergyRequest")
-                m_codec.encodeSignal(frame, sig, m_evParams.evEnergyRequest);
-        }
+    if (trace) trace->markOnce(LatencyTrace::Stage::TxEnqueued);
+    TxImage& image = m_txImages[static_cast<size_t>(message)];
+
+    // Re-encode only the signals whose parameter changed since the last send
+    for (uint32_t dirty = image.dirty; dirty != 0; dirty &= dirty - 1) {
+        encodeTxBinding(image.frame, image.bindings[std::countr_zero(dirty)]);
     }
+    image.dirty = 0;
 
-    sendFrame(frame);
+    CanFrame frame = image.frame;
+    frame.timestamp = std::chrono::steady_clock::now();
+    sendFrame(frame, trace);
 }
 
-void ChargeModule::sendFrame(const CanFrame& frame)
+void ChargeModule::sendFrame(const CanFrame& frame, LatencyTrace::Stamps* trace)
 {
     if (m_can && m_can->isOpen()) {
         m_can->write(frame);
+        if (trace) trace->mark(LatencyTrace::Stage::DriverWritten);
         emit rawFrameSent(frame);
     }
 }
@@ -2,14 +2,25 @@
 
 #include "module/state_machine.h"
 #include "module/safety_monitor.h"
+#include "module/charge_sequencer.h"
+#include "module/latency_trace.h"
+#include "module/tx_scheduler.h"
+#include "core/frame_decoder.h"
+#include "core/mpsc_queue.h"
+#include "core/seqlock.h"
 #include "can/can_interface.h"
 #include "can/can_frame.h"
 #include "dbc/dbc_parser.h"
 #include "dbc/signal_codec.h"
 
 #include <QObject>
+#include <QStringList>
+#include <QThread>
 #include <QTimer>
 #include <QMutex>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 
 namespace ccs {
@@ -17,6 +28,17 @@ namespace ccs {
 /// Main Charge Module S controller.
 /// Manages the protocol state machine, encodes/decodes CAN messages,
 /// and coordinates with the CMS module per datasheet requirements.
+///
+/// Intended to live on its own worker thread (moveToThread), away from the UI.
+/// Commands may be called from any thread. Parameter setters queue their change
+/// without locking; while running it is applied before the next cyclic send, in
+/// call order. The lifecycle commands forward themselves to the module thread and wait.
+/// Other threads read state through evseSnapshot() / evParamsSnapshot(), which are
+/// wait-free for the writer and never return a half-updated struct.
+///
+/// A Pooled module has no threads or timers of its own. Its owner (ChargerFleet)
+/// delivers RX frames to onFrameReceived() and calls serviceTimers() and the
+/// lifecycle commands serialised per module; serviceTx() may run on any thread.
 class ChargeModule : public QObject {
     Q_OBJECT
 public:
@@ -120,14 +142,42 @@ public:
         double measuredAttenuation = 0.0; // dB
     };
 
-    explicit ChargeModule(QObject* parent = nullptr);
+    /// One bit per EvseData member, in declaration order
+    enum class EvseField : uint8_t {
+        StateMachineState, AliveCounter, ControlPilotState, ControlPilotDutyCycle,
+        ActualChargeProtocol, ProximityPinState, SwS2Close, VoltageMatch,
+        EvseCompatible, TcpConnected, BcbStatus,
+        EvseMaxCurrent, EvseMaxVoltage, EvseMaxPower, EvseEnergyToBeDelivered,
+        EvseMinCurrent, EvseMinVoltage, EvsePeakCurrentRipple, EvseCurrentRegulationTolerance,
+        EvsePresentVoltage, EvsePresentCurrent, EvseIsolationStatus, EvseStatusCode,
+        EvseNotification, EvseNotificationMaxDelay,
+        EvseCurrentLimitAchieved, EvseVoltageLimitAchieved, EvsePowerLimitAchieved,
+        ErrorCode0, ErrorCode1, ErrorCode2, ErrorCode3,
+        SwVersionMajor, SwVersionMinor, SwVersionPatch, SwVersionConfig,
+        SlacState, LinkStatus, MeasuredAttenuation,
+        Count
+    };
+    using EvseFieldMask = uint64_t;
+    static_assert(static_cast<int>(EvseField::Count) <= 64, "EvseFieldMask has one bit per field");
+
+    static constexpr EvseFieldMask fieldBit(EvseField field) { return EvseFieldMask{1} << static_cast<int>(field); }
+
+    enum class Drive {
+        Standalone, // own TX scheduler thread, safety watchdog and notification timers
+        Pooled      // driven through serviceTx() / serviceTimers()
+    };
+
+    explicit ChargeModule(QObject* parent = nullptr, Drive drive = Drive::Standalone);
+    ~ChargeModule() override;
 
+    // Lifecycle commands, executed on the module thread
     void setCanInterface(CanInterface* iface);
     void loadDbc(const QString& dbcPath);
-    void start();  // Start cyclic TX
+    void setDatabase(const DbcDatabase& database);
+    void start();  // Start cyclic TX on the scheduler thread
     void stop();   // Stop cyclic TX, send safe defaults
 
-    // Parameter setters (validated by safety monitor)
+    // Parameter setters (validated by safety monitor), queued for the TX path
     void setEvMaxVoltage(double v);
     void setEvMaxCurrent(double i);
     void setEvMaxPower(double p);
@@ -152,16 +202,88 @@ public:
     void emergencyStop();
     void resetModule();
 
+    /// Live state, for use on the module thread only
     const EvParameters& evParams() const { return m_evParams; }
     const EvseData& evseData() const { return m_evseData; }
+
+    /// Consistent copies for any thread. The EVSE snapshot is republished after every
+    /// decoded frame that changed it; the parameters once queued setter calls are applied.
+    EvParameters evParamsSnapshot() const { return m_evParamsSnapshot.load(); }
+    EvseData evseSnapshot() const { return m_evseSnapshot.load(); }
+
+    /// EvseData keeps a field's last value after its message stops arriving. Each
+    /// field also keeps the receive time of the last frame that carried it, repeats
+    /// of an unchanged payload included, so readers on any thread can tell a steady
+    /// value from a stale one in O(1), without a timer per field.
+    using Clock = std::chrono::steady_clock;
+    /// Five cycles of the 100 ms CMS messages
+    static constexpr std::chrono::milliseconds DefaultMaxAge{500};
+    /// Time since a frame last set field; Clock::duration::max() if none has
+    Clock::duration age(EvseField field, Clock::time_point now = Clock::now()) const;
+    bool isFresh(EvseField field, Clock::duration maxAge = DefaultMaxAge, Clock::time_point now = Clock::now()) const
+    {
+        return age(field, now) <= maxAge;
+    }
+    /// The fields of mask older than maxAge
+    EvseFieldMask staleFields(EvseFieldMask fields, Clock::duration maxAge = DefaultMaxAge,
+                              Clock::time_point now = Clock::now()) const;
+
+    /// Latest value of every signal of every DBC message received, by signal handle
+    /// (DbcDatabase::signalHandle()); readable from any thread
+    const SignalTable& signalTable() const { return m_decoder.table(); }
+
     SafetyMonitor* safetyMonitor() { return &m_safety; }
     const DbcDatabase& dbcDatabase() const { return m_dbc; }
     const SignalCodec& codec() const { return m_codec; }
 
     bool isRunning() const { return m_running; }
 
+    /// Signals ChargeModule expects but the loaded DBC lacks (missing or renamed)
+    const QStringList& bindingWarnings() const { return m_bindingWarnings; }
+
+    /// Received frames of decoded messages that were decoded, and that were skipped
+    /// because their payload repeated the previous frame with the same ID
+    uint64_t rxDecodeCount() const { return m_decoder.decodedCount(); }
+    uint64_t rxDecodeSavedCount() const { return m_decoder.repeatedCount(); }
+
+    /// Default TX period for messages without GenMsgCycleTime
+    static constexpr int DefaultTxCycleMs = 100;
+
+    /// Period and phase of the cyclic VCU messages, in transmit order
+    QVector<TxScheduler::Entry> txSchedule() const;
+
+    /// Deadline-miss and jitter statistics of the cyclic VCU messages, in transmit order.
+    /// Empty for a Pooled module, whose owner schedules the sends.
+    QVector<TxScheduler::Statistics> txStatistics() const
+    {
+        return m_txScheduler ? m_txScheduler->statistics() : QVector<TxScheduler::Statistics>{};
+    }
+
+    // Pooled drive
+    /// Send cyclic message number entry of txSchedule(); any thread
+    void serviceTx(int entry);
+    /// Safety watchdog check and delayed change notifications; call every
+    /// ServiceIntervalMs, serialised with onFrameReceived()
+    void serviceTimers();
+    static constexpr int ServiceIntervalMs = 50;
+
+    /// Automatic PreCharge → Charge handoff, on by default; see ChargeSequencer.
+    /// The 2 A PreCharge limit applies either way.
+    void setSequencerEnabled(bool enabled) { m_sequencer.setEnabled(enabled); }
+    ChargeSequencer::Statistics sequencerStatistics() const { return m_sequencer.statistics(); }
+
+    /// Stage latencies of received frames and the reactions they trigger; on by default
+    LatencyTrace* latencyTrace() { return &m_latencyTrace; }
+
+    /// Upper bound on evseDataChanged() emissions per second; 0 emits on every change
+    static constexpr int DefaultMaxNotifyRateHz = 20;
+    void setMaxNotifyRate(int hz) { m_notifyIntervalMs = hz > 0 ? std::max(1000 / hz, 1) : 0; }
+
 signals:
-    void evseDataUpdated();
+    /// EvseData fields that changed since the previous emission. Changes are
+    /// coalesced to at most the configured rate; the first after a quiet period
+    /// is emitted at once, later ones at the end of the rate window.
+    void evseDataChanged(ccs::ChargeModule::EvseFieldMask changed);
     void stateChanged(ccs::CmsState newState);
     void errorCodeReceived(uint16_t code, const QString& description);
     void rawFrameReceived(const ccs::CanFrame& frame);
@@ -170,38 +292,160 @@ signals:
 public slots:
     void onFrameReceived(const ccs::CanFrame& frame);
 
-private slots:
-    void onCyclicTx();
-
 private:
-    void decodeChargeInfo(const CanFrame& frame);
-    void decodeEvseMaxLimits(const CanFrame& frame);
-    void decodeEvseRegulationLimits(const CanFrame& frame);
-    void decodeEvseDCStatus(const CanFrame& frame);
-    void decodeErrorCodes(const CanFrame& frame);
-    void decodeSoftwareInfo(const CanFrame& frame);
-    void decodeSLACInfo(const CanFrame& frame);
-
-    void sendEvDCMaxLimits();
-    void sendEvDCChargeTargets();
-    void sendEvStatusControl();
-    void sendEvStatusDisplay();
-    void sendEvPlugStatus();
-    void sendEvDCEnergyLimits();
-
-    void sendFrame(const CanFrame& frame);
-
-    CanInterface* m_can = nullptr;
+    /// CMS → VCU messages that are decoded into EvseData
+    enum class RxMessage : uint8_t {
+        ChargeInfo,
+        EvseDCMaxLimits,
+        EvseDCRegulationLimits,
+        EvseDCStatus,
+        ErrorCodes,
+        SoftwareInfo,
+        SlacInfo,
+        Count
+    };
+
+    /// Applies one decoded signal to EvseData; true when the field changed
+    using RxSetter = bool (*)(ChargeModule& module, uint64_t raw, double physical);
+
+    /// A DBC signal of an RX message bound to the EvseData field it updates
+    struct RxBinding {
+        int handle = -1;            // slot in m_decoder.values()
+        bool requireValid = false;  // ignore SNA values
+        EvseField field = EvseField::Count;
+        RxSetter apply = nullptr;
+    };
+
+    /// A Pooled module has no thread of its own; its owner serialises the calls
+    bool isOnModuleThread() const { return m_drive == Drive::Pooled || QThread::currentThread() == thread(); }
+
+    /// Message with EvseData bindings, RxMessage::Count for the other IDs
+    static RxMessage rxMessageFor(uint32_t canId);
+    void receiveFrame(const CanFrame& received);
+    void buildRxTables();
+    /// Hand the SafetyMonitor every DBC message this side receives, with its cycle time
+    void buildTimeoutMonitors();
+    /// Apply the decoded values to EvseData (when decoded) and react to the changes
+    void decodeRxMessage(RxMessage message, const CanFrame& frame, bool decoded);
+    /// Refresh the field times of message's bindings for a repeated payload
+    void touchRxFields(RxMessage message, Clock::time_point timestamp);
+    void noteEvseChanges(EvseFieldMask changed);
+    void flushEvseChanges(std::chrono::steady_clock::time_point now);
+    void checkEvseStatus();
+    void runSequencer(std::chrono::steady_clock::time_point rxTime);
+    /// Stamp stage of the frame being received; no-op outside the RX path or with tracing off
+    void stamp(LatencyTrace::Stage stage) { if (m_rxTrace) m_rxTrace->mark(stage); }
+
+    /// VCU → CMS messages, in transmit order
+    enum class TxMessage : uint8_t {
+        EvDCMaxLimits,
+        EvDCChargeTargets,
+        EvStatusControl,
+        EvStatusDisplay,
+        EvPlugStatus,
+        EvDCEnergyLimits,
+        Count
+    };
+
+    /// EvParameters members carried by a TX signal
+    enum class TxField : uint8_t {
+        EvMaxCurrent, EvMaxVoltage, EvMaxPower, EvFullSoC, EvBulkSoC,
+        EvTargetCurrent, EvTargetVoltage, EvPreChargeVoltage,
+        ChargeProgress, ChargeStop, EvReady, EvWeldingDetectionEnable,
+        ChargeProtocolPriority, BcbControl,
+        EvSoC, EvErrorCode, EvChargingComplete, EvBulkChargingComplete,
+        EvCabinConditioning, EvRessConditioning, EvTimeToFullSoC, EvTimeToBulkSoC,
+        EvControlPilotDutyCycle, EvControlPilotState, EvProximityPinState,
+        EvEnergyCapacity, EvEnergyRequest,
+        Count
+    };
+
+    /// A setter call waiting in m_commands. Set carries the already validated
+    /// value of one field; bools and enums are stored as their number.
+    struct ParamCommand {
+        enum class Op : uint8_t { Set, StartCharging, StopCharging };
+        Op op = Op::Set;
+        TxField field = TxField::Count;
+        double value = 0.0;
+    };
+    static constexpr size_t CommandQueueCapacity = 256;
+
+    void postCommand(const ParamCommand& command);
+    void postParam(TxField field, double value) { postCommand({ParamCommand::Op::Set, field, value}); }
+    void drainCommands();
+    void applyParam(TxField field, double value);
+
+    /// A DBC signal of a TX message bound to the field it carries
+    struct TxBinding {
+        const DbcSignal* sig = nullptr;
+        TxField field = TxField::Count;
+    };
+
+    /// Persistent encoded frame of one VCU message. Only bindings whose bit is set
+    /// in dirty are re-encoded before a send; an unchanged cycle is a frame copy.
+    struct TxImage {
+        CanFrame frame;
+        QVector<TxBinding> bindings;
+        uint32_t dirty = 0;
+    };
+
+    /// Where a field lives: image index and its binding's dirty bit
+    struct TxSlot {
+        int image = -1;
+        uint32_t bit = 0;
+    };
+
+    void buildTxImages();
+    void onTxDue(TxMessage message);
+    void markDirty(TxField field);
+    void encodeTxBinding(CanFrame& frame, const TxBinding& binding) const;
+    void sendTxMessage(TxMessage message, LatencyTrace::Stamps* trace = nullptr);
+    void applySafeState();
+    void publishEvParams() { m_evParamsSnapshot.store(m_evParams); }
+
+    void sendFrame(const CanFrame& frame, LatencyTrace::Stamps* trace = nullptr);
+
+    const Drive m_drive;
+    CanInterface* m_can = nullptr; // set on the module thread under m_mutex, read under m_mutex elsewhere
     DbcDatabase m_dbc;
     SignalCodec m_codec;
     SafetyMonitor m_safety;
+    ChargeSequencer m_sequencer;
+    LatencyTrace m_latencyTrace;
+    LatencyTrace::Stamps m_rxStamps;
+    LatencyTrace::Stamps* m_rxTrace = nullptr; // &m_rxStamps while a received frame is processed
 
     EvParameters m_evParams;
     EvseData m_evseData;
 
-    QTimer* m_cyclicTimer = nullptr;
-    bool m_running = false;
+    std::array<QVector<RxBinding>, static_cast<size_t>(RxMessage::Count)> m_rxTables;
+    FrameDecoder m_decoder; // RX lookup, repeat suppression, decode and signal table
+    /// Per EvseField: nanoseconds since the Clock epoch of the frame that last set it, 0 = never
+    std::array<std::atomic<int64_t>, static_cast<size_t>(EvseField::Count)> m_evseFieldTimeNs{};
+    QStringList m_bindingWarnings;
+
+    // Setter calls from any thread; consumed under m_mutex by drainCommands()
+    MpscQueue<ParamCommand, CommandQueueCapacity> m_commands;
+
+    // Published copies; m_evseData is written only on the module thread and
+    // m_evParams only under m_mutex, so each has a single writer at a time
+    SeqLock<EvseData> m_evseSnapshot;
+    SeqLock<EvParameters> m_evParamsSnapshot;
+
+    // Change notification coalescing, module thread. The timer flushes at the end
+    // of the window; a Pooled module has none and is flushed by serviceTimers().
+    QTimer* m_notifyTimer = nullptr;
+    EvseFieldMask m_pendingChanges = 0;
+    std::chrono::steady_clock::time_point m_notifyWindowEnd;
+    std::atomic<int> m_notifyIntervalMs{1000 / DefaultMaxNotifyRateHz};
+
+    std::array<TxImage, static_cast<size_t>(TxMessage::Count)> m_txImages;
+    std::array<TxSlot, static_cast<size_t>(TxField::Count)> m_txSlots;
+
+    TxScheduler* m_txScheduler = nullptr; // Standalone only
+    std::atomic<bool> m_running{false};
     CmsState m_lastState = CmsState::SNA;
+    CmsState m_paramState = CmsState::SNA; // m_evseData's state as drainCommands() sees it, under m_mutex
     mutable QMutex m_mutex;
 };
 
@@ -0,0 +1,68 @@
+#include "module/charge_sequencer.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace ccs {
+
+ChargeSequencer::Actions ChargeSequencer::onChargeInfo(CmsState state, bool voltageMatch, bool chargingRequested,
+                                                       bool startSent, Clock::time_point rxTime)
+{
+    const bool enteredPreCharge = state == CmsState::PreCharge && m_state != CmsState::PreCharge;
+    m_state = state;
+    if (enteredPreCharge) {
+        m_preChargeEntered = rxTime;
+    }
+
+    Actions actions = NoAction;
+    if (enteredPreCharge) {
+        actions |= LimitPreChargeCurrent;
+    }
+    if (m_enabled && state == CmsState::PreCharge && voltageMatch && chargingRequested && !startSent) {
+        actions |= StartCharge;
+    }
+    return actions;
+}
+
+void ChargeSequencer::noteReaction(Actions actions, Clock::time_point rxTime, Clock::time_point sentTime)
+{
+    const int64_t reactionUs = std::chrono::duration_cast<std::chrono::microseconds>(sentTime - rxTime).count();
+    m_reactions.fetch_add(1, std::memory_order_relaxed);
+    m_lastReactionUs.store(reactionUs, std::memory_order_relaxed);
+    m_maxReactionUs.store(std::max(m_maxReactionUs.load(std::memory_order_relaxed), reactionUs),
+                          std::memory_order_relaxed);
+
+    if (actions & LimitPreChargeCurrent) {
+        qDebug().noquote() << QString("Sequencer: PreCharge target current %1 A sent %2 ms after ChargeInfo")
+            .arg(PreChargeCurrentA, 0, 'f', 0).arg(reactionUs / 1000.0, 0, 'f', 2);
+    }
+    if (actions & StartCharge) {
+        const int64_t preChargeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            sentTime - m_preChargeEntered).count();
+        m_lastPreChargeMs.store(preChargeMs, std::memory_order_relaxed);
+        const QString message = QString("Sequencer: ChargeProgressIndication=Start sent %1 ms after ChargeInfo, "
+                                        "%2 ms into PreCharge (CMS timeout %3 ms)")
+            .arg(reactionUs / 1000.0, 0, 'f', 2).arg(preChargeMs).arg(PreChargeTimeoutMs);
+        if (preChargeMs >= PreChargeTimeoutMs) {
+            qWarning().noquote() << message;
+        } else {
+            qDebug().noquote() << message;
+        }
+    }
+}
+
+void ChargeSequencer::reset()
+{
+    m_state = CmsState::SNA;
+}
+
+ChargeSequencer::Statistics ChargeSequencer::statistics() const
+{
+    Statistics stats;
+    stats.reactions = m_reactions.load(std::memory_order_relaxed);
+    stats.lastReactionUs = m_lastReactionUs.load(std::memory_order_relaxed);
+    stats.maxReactionUs = m_maxReactionUs.load(std::memory_order_relaxed);
+    stats.lastPreChargeMs = m_lastPreChargeMs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace ccs
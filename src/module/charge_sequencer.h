@@ -0,0 +1,80 @@
+#pragma once
+
+#include "module/state_machine.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ccs {
+
+/// Drives the VCU side of the CMS state machine from decoded ChargeInfo.
+///
+/// ChargeModule feeds it every StateMachineState / VoltageMatch change, and every
+/// ChargeInfo received during PreCharge, straight from the RX path on the module
+/// thread. It performs the returned actions at once with an out-of-cycle send
+/// instead of waiting for the next TX cycle:
+///
+/// - entering PreCharge: EVTargetCurrent is fixed at 2 A (EVDCChargeTargets)
+/// - PreCharge with VoltageMatch, charging requested: ChargeProgressIndication=Start
+///   (EVStatusControl), which lets the CMS enter Charge. Charging requested after
+///   VoltageMatch is picked up by the next ChargeInfo.
+///
+/// The CMS aborts PreCharge after PreChargeTimeoutMs, so the latency from the
+/// triggering frame to the send and the time spent in PreCharge are recorded.
+class ChargeSequencer {
+public:
+    enum Action : uint8_t {
+        NoAction              = 0,
+        LimitPreChargeCurrent = 1 << 0,
+        StartCharge           = 1 << 1,
+    };
+    using Actions = uint8_t;
+
+    /// Current fixed by the datasheet while the EVSE pre-charges
+    static constexpr double PreChargeCurrentA = 2.0;
+    /// CMS gives up on PreCharge after this long
+    static constexpr int PreChargeTimeoutMs = 7000;
+
+    struct Statistics {
+        uint64_t reactions = 0;          // out-of-cycle sends
+        int64_t lastReactionUs = 0;      // triggering frame received → frame written
+        int64_t maxReactionUs = 0;
+        int64_t lastPreChargeMs = -1;    // PreCharge entered → Start sent, -1 before the first
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    /// Off: Start is left to the application. The PreCharge current limit is a
+    /// datasheet requirement and is still returned.
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    /// A ChargeInfo frame received at rxTime changed state or voltageMatch, or arrived during PreCharge.
+    /// chargingRequested: EVReady set and no stop requested. startSent: the
+    /// current ChargeProgressIndication is already Start.
+    Actions onChargeInfo(CmsState state, bool voltageMatch, bool chargingRequested, bool startSent,
+                         Clock::time_point rxTime);
+
+    /// The actions for the frame received at rxTime were sent at sentTime
+    void noteReaction(Actions actions, Clock::time_point rxTime, Clock::time_point sentTime);
+
+    /// Forget the tracked state, e.g. when cyclic TX stops
+    void reset();
+
+    /// Any thread
+    Statistics statistics() const;
+
+private:
+    std::atomic<bool> m_enabled{true};
+
+    // Module thread
+    CmsState m_state = CmsState::SNA;
+    Clock::time_point m_preChargeEntered;
+
+    std::atomic<uint64_t> m_reactions{0};
+    std::atomic<int64_t> m_lastReactionUs{0};
+    std::atomic<int64_t> m_maxReactionUs{0};
+    std::atomic<int64_t> m_lastPreChargeMs{-1};
+};
+
+} // namespace ccs
@@ -0,0 +1,219 @@
+#include "module/charger_fleet.h"
+#include "dbc/dbc_parser.h"
+#include <QDebug>
+#include <algorithm>
+#include <utility>
+
+namespace ccs {
+
+ChargerFleet::ChargerFleet(int workerCount, QObject* parent)
+    : QObject(parent)
+    , m_pool(std::make_unique<WorkStealingPool>(workerCount))
+{
+    m_dispatcher = new TxScheduler(this);
+    m_dispatcher->setSendFunction([this](int entry) { dispatch(entry); });
+}
+
+ChargerFleet::~ChargerFleet()
+{
+    stop();
+    // No more frames from the interfaces' threads: their handlers reference the members
+    for (const auto& member : m_members) {
+        disconnect(member->can, &CanInterface::frameReceived, this, nullptr);
+    }
+    // Drain and join the workers before the modules (children) are deleted
+    m_pool.reset();
+}
+
+int ChargerFleet::addModule(CanInterface* iface)
+{
+    if (m_running) {
+        qWarning() << "ChargerFleet: modules cannot be added while running";
+        return -1;
+    }
+
+    auto member = std::make_unique<Member>();
+    member->module = new ChargeModule(this, ChargeModule::Drive::Pooled);
+    member->can = iface;
+    member->module->setCanInterface(iface);
+
+    // Direct: the frame is only queued here, on whichever thread received it
+    Member* target = member.get();
+    connect(iface, &CanInterface::frameReceived, this, [this, target](const CanFrame& frame) {
+        post(*target, [&frame](Member& m) { m.work.append(frame); });
+    }, Qt::DirectConnection);
+
+    m_members.push_back(std::move(member));
+    return moduleCount() - 1;
+}
+
+bool ChargerFleet::loadDbc(const QString& dbcPath)
+{
+    if (m_running) {
+        m_lastError = "Stop the fleet before loading a DBC";
+        return false;
+    }
+
+    DbcParser parser;
+    if (!parser.parse(dbcPath)) {
+        m_lastError = parser.lastError();
+        return false;
+    }
+
+    // Through the module queues, so no RX decode runs while the tables are rebuilt
+    auto database = std::make_shared<const DbcDatabase>(parser.database());
+    for (int i = 0; i < moduleCount(); ++i) {
+        postCommand(i, [database](ChargeModule& module) { module.setDatabase(*database); });
+    }
+    waitIdle();
+
+    qDebug() << "ChargerFleet: DBC" << database->name << "loaded into" << moduleCount() << "modules";
+    if (!m_members.empty()) {
+        // Same database, same warnings for every module
+        for (const auto& warning : m_members.front()->module->bindingWarnings()) {
+            qWarning() << "DBC binding:" << warning;
+        }
+    }
+    return true;
+}
+
+void ChargerFleet::start()
+{
+    if (m_running || m_members.empty()) return;
+
+    // Through the module queues, like every lifecycle command: a worker may be decoding
+    for (int i = 0; i < moduleCount(); ++i) {
+        postCommand(i, [](ChargeModule& module) { module.start(); });
+    }
+    waitIdle();
+
+    // The modules share one schedule; the last entry ticks their timers
+    QVector<TxScheduler::Entry> entries = m_members.front()->module->txSchedule();
+    m_txEntries = entries.size();
+    entries.append({ChargeModule::ServiceIntervalMs, 0});
+    m_dispatcher->setEntries(entries);
+
+    m_running = true;
+    m_dispatcher->startScheduling();
+    qDebug() << "ChargerFleet: started" << moduleCount() << "modules on"
+             << m_pool->threadCount() << "workers";
+}
+
+void ChargerFleet::stop()
+{
+    if (!m_running) return;
+    m_running = false;
+
+    m_dispatcher->stopScheduling();
+    for (int i = 0; i < moduleCount(); ++i) {
+        postCommand(i, [](ChargeModule& module) { module.stop(); });
+    }
+    waitIdle();
+}
+
+void ChargerFleet::postFrame(int index, const CanFrame& frame)
+{
+    post(*m_members[index], [&frame](Member& m) { m.work.append(frame); });
+}
+
+void ChargerFleet::postCommand(int index, std::function<void(ChargeModule&)> command)
+{
+    post(*m_members[index], [&command](Member& m) { m.work.append(std::move(command)); });
+}
+
+ChargerFleet::Statistics ChargerFleet::statistics() const
+{
+    Statistics stats;
+    stats.rxFrames = m_rxFrames;
+    stats.txDispatched = m_txDispatched;
+    stats.maxQueueDelayUs = m_maxQueueDelayUs;
+    for (const auto& entry : m_dispatcher->statistics()) {
+        stats.txMissed += entry.missed;
+        stats.maxDispatchJitterUs = std::max(stats.maxDispatchJitterUs, entry.maxJitterUs);
+    }
+    const auto pool = m_pool->statistics();
+    stats.tasksExecuted = pool.executed;
+    stats.tasksStolen = pool.stolen;
+    stats.workerCount = m_pool->threadCount();
+    return stats;
+}
+
+// ─── Module queues ───────────────────────────────────────
+
+template <typename Enqueue>
+void ChargerFleet::post(Member& member, Enqueue&& enqueue)
+{
+    bool schedule;
+    {
+        QMutexLocker lock(&member.mutex);
+        enqueue(member);
+        schedule = !std::exchange(member.scheduled, true);
+    }
+    if (schedule) {
+        m_pool->submit([this, &member] { drain(member); });
+    }
+}
+
+void ChargerFleet::drain(Member& member)
+{
+    QVector<Work> work;
+    for (;;) {
+        bool timers;
+        {
+            QMutexLocker lock(&member.mutex);
+            if (member.work.isEmpty() && !member.timersDue) {
+                member.scheduled = false;
+                return;
+            }
+            work.swap(member.work);
+            timers = std::exchange(member.timersDue, false);
+        }
+
+        uint64_t frames = 0;
+        for (auto& item : work) {
+            if (const auto* frame = std::get_if<CanFrame>(&item)) {
+                member.module->onFrameReceived(*frame);
+                ++frames;
+            } else {
+                std::get<Command>(item)(*member.module);
+            }
+        }
+        m_rxFrames.fetch_add(frames, std::memory_order_relaxed);
+        if (timers) {
+            member.module->serviceTimers();
+        }
+        work.clear();
+    }
+}
+
+// ─── Dispatcher thread ───────────────────────────────────
+
+void ChargerFleet::dispatch(int entry)
+{
+    if (entry >= m_txEntries) {
+        for (const auto& member : m_members) {
+            post(*member, [](Member& m) { m.timersDue = true; });
+        }
+        return;
+    }
+
+    const auto queued = std::chrono::steady_clock::now();
+    for (const auto& member : m_members) {
+        ChargeModule* module = member->module;
+        m_pool->submit([this, module, entry, queued] {
+            noteQueueDelay(queued);
+            module->serviceTx(entry);
+        });
+    }
+    m_txDispatched.fetch_add(m_members.size(), std::memory_order_relaxed);
+}
+
+void ChargerFleet::noteQueueDelay(std::chrono::steady_clock::time_point queued)
+{
+    const int64_t delayUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - queued).count();
+    int64_t max = m_maxQueueDelayUs.load(std::memory_order_relaxed);
+    while (delayUs > max && !m_maxQueueDelayUs.compare_exchange_weak(max, delayUs, std::memory_order_relaxed)) {}
+}
+
+} // namespace ccs
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "module/charge_module.h"
+#include "module/tx_scheduler.h"
+#include "module/work_stealing_pool.h"
+#include "can/can_interface.h"
+
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <variant>
+#include <vector>
+
+namespace ccs {
+
+/// Runs many ChargeModules, each on its own CAN channel or simulated bus, with no
+/// thread or timer per module.
+///
+/// The modules are Pooled. Their RX decode, cyclic TX and safety/notification
+/// ticks run as tasks on one WorkStealingPool. A single TxScheduler thread wakes
+/// at every deadline of the shared schedule and queues the due work for all modules.
+/// RX frames, timer ticks and commands for one module go through a per-module
+/// queue, drained by at most one task at a time, so each module still sees them
+/// one after another; frames and commands keep their arrival order. Cyclic sends are locked by the module itself and run in
+/// parallel with that queue.
+///
+/// All modules share the fleet's DBC, and so its TX schedule.
+class ChargerFleet : public QObject {
+    Q_OBJECT
+public:
+    struct Statistics {
+        uint64_t rxFrames = 0;          // frames handed to modules
+        uint64_t txDispatched = 0;      // cyclic sends queued (modules × due messages)
+        uint64_t txMissed = 0;          // schedule slots skipped: dispatcher woke a period late
+        int64_t maxDispatchJitterUs = 0; // dispatcher wake-up lateness
+        int64_t maxQueueDelayUs = 0;    // queued until started on a worker
+        uint64_t tasksExecuted = 0;
+        uint64_t tasksStolen = 0;
+        int workerCount = 0;
+    };
+
+    /// workerCount 0 uses one worker per hardware thread
+    explicit ChargerFleet(int workerCount = 0, QObject* parent = nullptr);
+    ~ChargerFleet() override;
+
+    /// Add a module bound to iface (not owned, must outlive the fleet), whose
+    /// received frames are routed to it. Returns its index, or -1 while running.
+    int addModule(CanInterface* iface);
+    int moduleCount() const { return static_cast<int>(m_members.size()); }
+    ChargeModule* module(int index) const { return m_members[index]->module; }
+
+    /// Parse once and hand the database to every module; only while stopped
+    bool loadDbc(const QString& dbcPath);
+    QString lastError() const { return m_lastError; }
+
+    void start();
+    /// Stop dispatching, wait for queued work, then send every module's safe state
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    /// Queue a received frame for module index; any thread
+    void postFrame(int index, const CanFrame& frame);
+    /// Run command on module index, in order with its RX frames; any thread
+    void postCommand(int index, std::function<void(ChargeModule&)> command);
+
+    /// Wait until every queued RX, TX, timer and command task has run
+    void waitIdle() { m_pool->waitIdle(); }
+
+    Statistics statistics() const;
+
+private:
+    /// Work queue of one module. scheduled is set while a drain task for it is
+    /// queued or running; only that task touches the module's RX side.
+    using Command = std::function<void(ChargeModule&)>;
+    /// A received frame or a command, queued together so they run in arrival order
+    using Work = std::variant<CanFrame, Command>;
+
+    struct Member {
+        ChargeModule* module = nullptr;
+        CanInterface* can = nullptr;
+
+        QMutex mutex;
+        QVector<Work> work;
+        bool timersDue = false;
+        bool scheduled = false;
+    };
+
+    /// Run enqueue under the member's lock, then make sure a drain task is queued
+    template <typename Enqueue>
+    void post(Member& member, Enqueue&& enqueue);
+    void drain(Member& member);
+    void dispatch(int entry);
+    void noteQueueDelay(std::chrono::steady_clock::time_point queued);
+
+    std::unique_ptr<WorkStealingPool> m_pool;
+    TxScheduler* m_dispatcher = nullptr;
+    std::vector<std::unique_ptr<Member>> m_members;
+    int m_txEntries = 0; // dispatcher entries before the timer entry
+    bool m_running = false;
+    QString m_lastError;
+
+    std::atomic<uint64_t> m_rxFrames{0};
+    std::atomic<uint64_t> m_txDispatched{0};
+    std::atomic<int64_t> m_maxQueueDelayUs{0};
+};
+
+} // namespace ccs
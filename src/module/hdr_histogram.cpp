@@ -0,0 +1,151 @@
+#include "module/hdr_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace ccs {
+
+int HdrHistogram::countsIndex(uint64_t value)
+{
+    // Bucket: position of the highest bit above the sub-bucket range
+    const int bucketIndex = 63 - std::countl_zero(value | SubBucketMask) - SubBucketHalfCountMagnitude;
+    const int subBucketIndex = static_cast<int>(value >> bucketIndex);
+    return ((bucketIndex + 1) << SubBucketHalfCountMagnitude) + (subBucketIndex - SubBucketHalfCount);
+}
+
+uint64_t HdrHistogram::valueFromIndex(int index)
+{
+    int bucketIndex = (index >> SubBucketHalfCountMagnitude) - 1;
+    int subBucketIndex = (index & (SubBucketHalfCount - 1)) + SubBucketHalfCount;
+    if (bucketIndex < 0) {
+        subBucketIndex -= SubBucketHalfCount;
+        bucketIndex = 0;
+    }
+    return static_cast<uint64_t>(subBucketIndex) << bucketIndex;
+}
+
+uint64_t HdrHistogram::highestEquivalentValue(int index)
+{
+    const int bucketIndex = std::max((index >> SubBucketHalfCountMagnitude) - 1, 0);
+    return valueFromIndex(index) + (uint64_t{1} << bucketIndex) - 1;
+}
+
+void HdrHistogram::record(uint64_t value)
+{
+    value = std::min(value, MaxValue);
+    m_counts[countsIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t min = m_min.load(std::memory_order_relaxed);
+    while (value < min && !m_min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+void HdrHistogram::reset()
+{
+    for (auto& count : m_counts) count.store(0, std::memory_order_relaxed);
+    m_total.store(0, std::memory_order_relaxed);
+    m_min.store(UINT64_MAX, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+void HdrHistogram::add(const HdrHistogram& other)
+{
+    for (int i = 0; i < CountsLength; ++i) {
+        const uint64_t count = other.m_counts[i].load(std::memory_order_relaxed);
+        if (count) m_counts[i].fetch_add(count, std::memory_order_relaxed);
+    }
+    m_total.fetch_add(other.totalCount(), std::memory_order_relaxed);
+    if (other.totalCount()) {
+        uint64_t min = m_min.load(std::memory_order_relaxed);
+        const uint64_t otherMin = other.m_min.load(std::memory_order_relaxed);
+        while (otherMin < min && !m_min.compare_exchange_weak(min, otherMin, std::memory_order_relaxed)) {}
+        uint64_t max = m_max.load(std::memory_order_relaxed);
+        const uint64_t otherMax = other.max();
+        while (otherMax > max && !m_max.compare_exchange_weak(max, otherMax, std::memory_order_relaxed)) {}
+    }
+}
+
+uint64_t HdrHistogram::min() const
+{
+    return totalCount() ? m_min.load(std::memory_order_relaxed) : 0;
+}
+
+double HdrHistogram::mean() const
+{
+    const uint64_t total = totalCount();
+    if (total == 0) return 0.0;
+
+    double sum = 0.0;
+    for (int i = 0; i < CountsLength; ++i) {
+        const uint64_t count = m_counts[i].load(std::memory_order_relaxed);
+        if (count) {
+            const double median = (static_cast<double>(valueFromIndex(i)) + static_cast<double>(highestEquivalentValue(i))) / 2.0;
+            sum += median * static_cast<double>(count);
+        }
+    }
+    return sum / static_cast<double>(total);
+}
+
+uint64_t HdrHistogram::valueAtPercentile(double percentile) const
+{
+    const uint64_t total = totalCount();
+    if (total == 0) return 0;
+
+    const double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (int i = 0; i < CountsLength; ++i) {
+        seen += m_counts[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(highestEquivalentValue(i), max());
+        }
+    }
+    return max();
+}
+
+void HdrHistogram::writePercentiles(QTextStream& out, double unitScale) const
+{
+    // Snapshot, so the rows add up while other threads keep recording
+    std::array<uint64_t, CountsLength> counts;
+    uint64_t total = 0;
+    for (int i = 0; i < CountsLength; ++i) {
+        counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    out << "       Value     Percentile TotalCount 1/(1-Percentile)\n\n";
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    uint64_t seen = 0;
+    for (int i = 0; i < CountsLength; ++i) {
+        if (counts[i] == 0) continue;
+        seen += counts[i];
+        const double value = static_cast<double>(highestEquivalentValue(i)) / unitScale;
+        const double percentile = static_cast<double>(seen) / static_cast<double>(total);
+        out << QString("%1").arg(value, 12, 'f', 3) << ' '
+            << QString("%1").arg(percentile, 14, 'f', 12) << ' '
+            << QString("%1").arg(seen, 10);
+        if (seen < total) {
+            out << ' ' << QString("%1").arg(1.0 / (1.0 - percentile), 14, 'f', 2);
+        }
+        out << '\n';
+
+        const double median = (static_cast<double>(valueFromIndex(i)) + static_cast<double>(highestEquivalentValue(i)))
+                              / 2.0 / unitScale;
+        sum += median * static_cast<double>(counts[i]);
+        sumSquares += median * median * static_cast<double>(counts[i]);
+    }
+
+    const double mean = total ? sum / static_cast<double>(total) : 0.0;
+    const double variance = total ? std::max(sumSquares / static_cast<double>(total) - mean * mean, 0.0) : 0.0;
+    out << "#[Mean    = " << QString("%1").arg(mean, 12, 'f', 3)
+        << ", StdDeviation   = " << QString("%1").arg(std::sqrt(variance), 12, 'f', 3) << "]\n";
+    out << "#[Max     = " << QString("%1").arg(static_cast<double>(max()) / unitScale, 12, 'f', 3)
+        << ", Total count    = " << QString("%1").arg(total, 12) << "]\n";
+    out << "#[Buckets = " << QString("%1").arg(BucketCount, 12)
+        << ", SubBuckets     = " << QString("%1").arg(SubBucketCount, 12) << "]\n";
+}
+
+} // namespace ccs
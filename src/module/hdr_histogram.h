@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QString>
+#include <QTextStream>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ccs {
+
+/// High-dynamic-range histogram of unsigned values (HdrHistogram layout).
+///
+/// Values are counted in buckets whose width doubles with each power of two,
+/// each split into 64 sub-buckets, so any value is stored within 1/64 (~1.6 %)
+/// of itself from 1 up to 2^MaxValueMagnitude. Larger values are clamped.
+/// record() is a relaxed atomic increment: any number of threads may record
+/// while another reads.
+class HdrHistogram {
+public:
+    static constexpr int SubBucketHalfCountMagnitude = 6;
+    static constexpr int MaxValueMagnitude = 40;
+
+    void record(uint64_t value);
+    void reset();
+    /// Add other's counts to this histogram
+    void add(const HdrHistogram& other);
+
+    uint64_t totalCount() const { return m_total.load(std::memory_order_relaxed); }
+    uint64_t min() const;
+    uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+    double mean() const;
+    /// Smallest recorded value (bucket's highest equivalent) at or above percentile of the counts
+    uint64_t valueAtPercentile(double percentile) const;
+
+    /// Percentile distribution in the HdrHistogram .hgrm text format. Values are
+    /// divided by unitScale, e.g. ticks per microsecond to print microseconds.
+    void writePercentiles(QTextStream& out, double unitScale) const;
+
+private:
+    static constexpr int SubBucketHalfCount = 1 << SubBucketHalfCountMagnitude;
+    static constexpr int SubBucketCount = SubBucketHalfCount * 2;
+    static constexpr uint64_t SubBucketMask = SubBucketCount - 1;
+    static constexpr int BucketCount = MaxValueMagnitude - SubBucketHalfCountMagnitude;
+    static constexpr int CountsLength = (BucketCount + 1) * SubBucketHalfCount;
+    static constexpr uint64_t MaxValue = (uint64_t{1} << MaxValueMagnitude) - 1;
+
+    static int countsIndex(uint64_t value);
+    static uint64_t valueFromIndex(int index);
+    /// Largest value that shares index's bucket
+    static uint64_t highestEquivalentValue(int index);
+
+    std::array<std::atomic<uint64_t>, CountsLength> m_counts{};
+    std::atomic<uint64_t> m_total{0};
+    std::atomic<uint64_t> m_min{UINT64_MAX};
+    std::atomic<uint64_t> m_max{0};
+};
+
+} // namespace ccs
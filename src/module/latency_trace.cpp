@@ -0,0 +1,140 @@
+#include "module/latency_trace.h"
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+namespace ccs {
+
+LatencyTrace::~LatencyTrace()
+{
+    for (auto& path : m_paths) {
+        delete path.load(std::memory_order_relaxed);
+    }
+}
+
+LatencyTrace::PathHistograms& LatencyTrace::histograms(Path path)
+{
+    auto& slot = m_paths[static_cast<size_t>(path)];
+    PathHistograms* histograms = slot.load(std::memory_order_acquire);
+    if (!histograms) {
+        // Single writer per path: no other thread allocates concurrently
+        histograms = new PathHistograms;
+        slot.store(histograms, std::memory_order_release);
+    }
+    return *histograms;
+}
+
+void LatencyTrace::record(Path path, const Stamps& stamps, Stage last)
+{
+    if (!isEnabled()) return;
+
+    PathHistograms& target = histograms(path);
+    uint64_t first = 0;
+    uint64_t previous = 0;
+    for (size_t stage = 0; stage <= static_cast<size_t>(last); ++stage) {
+        const uint64_t ticks = stamps.ticks[stage];
+        if (ticks == 0) continue;
+        if (previous != 0) {
+            // The counter can step back across cores on old CPUs; count that as zero
+            target[stage].record(ticks > previous ? ticks - previous : 0);
+        } else {
+            first = ticks;
+        }
+        previous = ticks;
+    }
+    if (first != 0 && previous != first) {
+        target[static_cast<size_t>(Stage::DriverReceive)].record(previous > first ? previous - first : 0);
+    }
+}
+
+const HdrHistogram* LatencyTrace::histogram(Path path, Stage stage) const
+{
+    const PathHistograms* histograms = m_paths[static_cast<size_t>(path)].load(std::memory_order_acquire);
+    return histograms ? &(*histograms)[static_cast<size_t>(stage)] : nullptr;
+}
+
+QString LatencyTrace::summary() const
+{
+    const double ticksPerUs = TscClock::ticksPerNanosecond() * 1000.0;
+    const auto us = [ticksPerUs](uint64_t ticks) {
+        return QString::number(static_cast<double>(ticks) / ticksPerUs, 'f', 1);
+    };
+
+    QString text;
+    for (size_t p = 0; p < static_cast<size_t>(Path::Count); ++p) {
+        for (size_t s = 0; s < static_cast<size_t>(Stage::Count); ++s) {
+            const HdrHistogram* h = histogram(static_cast<Path>(p), static_cast<Stage>(s));
+            if (!h || h->totalCount() == 0) continue;
+            text += QString("%1.%2: n=%3 p50=%4 p99=%5 p99.9=%6 max=%7 us\n")
+                .arg(pathName(static_cast<Path>(p)), stageName(static_cast<Stage>(s)))
+                .arg(h->totalCount())
+                .arg(us(h->valueAtPercentile(50.0)), us(h->valueAtPercentile(99.0)),
+                     us(h->valueAtPercentile(99.9)), us(h->max()));
+        }
+    }
+    return text;
+}
+
+bool LatencyTrace::exportHistograms(const QString& directory, QString* error) const
+{
+    if (!QDir().mkpath(directory)) {
+        if (error) *error = "Cannot create " + directory;
+        return false;
+    }
+
+    const double ticksPerUs = TscClock::ticksPerNanosecond() * 1000.0;
+    const QDir dir(directory);
+    for (size_t p = 0; p < static_cast<size_t>(Path::Count); ++p) {
+        for (size_t s = 0; s < static_cast<size_t>(Stage::Count); ++s) {
+            const HdrHistogram* h = histogram(static_cast<Path>(p), static_cast<Stage>(s));
+            if (!h || h->totalCount() == 0) continue;
+
+            QFile file(dir.filePath(QString("%1.%2.hgrm")
+                .arg(pathName(static_cast<Path>(p)), stageName(static_cast<Stage>(s)))));
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                if (error) *error = "Cannot write " + file.fileName();
+                return false;
+            }
+            QTextStream out(&file);
+            h->writePercentiles(out, ticksPerUs);
+        }
+    }
+    return true;
+}
+
+void LatencyTrace::reset()
+{
+    for (auto& slot : m_paths) {
+        if (PathHistograms* histograms = slot.load(std::memory_order_acquire)) {
+            for (auto& h : *histograms) h.reset();
+        }
+    }
+}
+
+const char* LatencyTrace::pathName(Path path)
+{
+    switch (path) {
+        case Path::RxDecode:      return "rx_decode";
+        case Path::Sequencer:     return "sequencer";
+        case Path::EmergencyStop: return "emergency_stop";
+        case Path::Count:         break;
+    }
+    return "unknown";
+}
+
+const char* LatencyTrace::stageName(Stage stage)
+{
+    // A histogram is named after the stage it ends at; DriverReceive holds the total
+    switch (stage) {
+        case Stage::DriverReceive: return "total";
+        case Stage::Dequeued:      return "dequeued";
+        case Stage::Decoded:       return "decoded";
+        case Stage::Decided:       return "decided";
+        case Stage::TxEnqueued:    return "tx_enqueued";
+        case Stage::DriverWritten: return "driver_written";
+        case Stage::Count:         break;
+    }
+    return "unknown";
+}
+
+} // namespace ccs
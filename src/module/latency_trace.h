@@ -0,0 +1,82 @@
+#pragma once
+
+#include "core/tsc_clock.h"
+#include "module/hdr_histogram.h"
+#include <QString>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ccs {
+
+/// Per-stage latency of the RX → decision → TX pipeline.
+///
+/// Each frame carries Stamps through the pipeline; every stage it passes writes
+/// TscClock ticks into its slot. When the frame's path ends, record() adds the
+/// time between consecutive stamped stages, and from the first to the last, to
+/// that path's HDR histograms. Unstamped stages are skipped.
+///
+/// One writer per path at a time (the module thread); export from any thread.
+class LatencyTrace {
+public:
+    enum class Stage : uint8_t {
+        DriverReceive, // CAN driver read the frame (CanFrame::rxTicks)
+        Dequeued,      // module started on it
+        Decoded,       // signals applied to EvseData
+        Decided,       // safety evaluation or sequencer decision made
+        TxEnqueued,    // reaction handed to the TX path
+        DriverWritten, // CAN driver write returned
+        Count
+    };
+
+    enum class Path : uint8_t {
+        RxDecode,      // every decoded frame, up to Decided
+        Sequencer,     // ChargeInfo edge → out-of-cycle EVStatusControl
+        EmergencyStop, // EVSE emergency/malfunction → safe-state EVStatusControl
+        Count
+    };
+
+    struct Stamps {
+        std::array<uint64_t, static_cast<size_t>(Stage::Count)> ticks{};
+
+        void mark(Stage stage) { ticks[static_cast<size_t>(stage)] = TscClock::now(); }
+        /// Keep the first stamp, e.g. the first of several sends
+        void markOnce(Stage stage) { if (!ticks[static_cast<size_t>(stage)]) mark(stage); }
+    };
+
+    LatencyTrace() = default;
+    ~LatencyTrace();
+    LatencyTrace(const LatencyTrace&) = delete;
+    LatencyTrace& operator=(const LatencyTrace&) = delete;
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /// Add stamps of one frame, for the stages up to and including last
+    void record(Path path, const Stamps& stamps, Stage last = Stage::DriverWritten);
+
+    /// Histogram of the time to reach stage from the previous stamped stage, in
+    /// ticks; stage DriverReceive holds the total. Null while path has no samples.
+    const HdrHistogram* histogram(Path path, Stage stage) const;
+
+    /// One line per path and stage with count and p50/p99/p99.9/max in microseconds
+    QString summary() const;
+    /// One .hgrm file per recorded path and stage, values in microseconds, e.g.
+    /// emergency_stop.total.hgrm, emergency_stop.tx_enqueued.hgrm
+    bool exportHistograms(const QString& directory, QString* error = nullptr) const;
+    void reset();
+
+    static const char* pathName(Path path);
+    static const char* stageName(Stage stage);
+
+private:
+    using PathHistograms = std::array<HdrHistogram, static_cast<size_t>(Stage::Count)>;
+
+    /// Allocated on the path's first sample, so unused paths cost no memory
+    PathHistograms& histograms(Path path);
+
+    std::atomic<bool> m_enabled{true};
+    std::array<std::atomic<PathHistograms*>, static_cast<size_t>(Path::Count)> m_paths{};
+};
+
+} // namespace ccs
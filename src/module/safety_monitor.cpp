@@ -1,18 +1,39 @@
 #include "module/safety_monitor.h"
 #include <QDebug>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace ccs {
 
+namespace {
+
+/// Wheel time: whole milliseconds of the steady clock, rounded down...
+uint64_t toTick(std::chrono::steady_clock::time_point time)
+{
+    return static_cast<uint64_t>(
+        std::chrono::floor<std::chrono::milliseconds>(time.time_since_epoch()).count());
+}
+
+/// ...and deadlines rounded up, so a timeout never fires early
+uint64_t deadlineTick(std::chrono::steady_clock::time_point time, int timeoutMs)
+{
+    return static_cast<uint64_t>(
+        std::chrono::ceil<std::chrono::milliseconds>(time.time_since_epoch()).count()) + timeoutMs;
+}
+
+} // namespace
+
 SafetyMonitor::SafetyMonitor(QObject* parent)
     : QObject(parent)
 {
-    m_lastAliveTime = std::chrono::steady_clock::now();
+    m_wheel.reset(1, toTick(std::chrono::steady_clock::now())); // the heartbeat until messages are set
 
+    // Single-shot at the wheel's next deadline rather than a periodic poll
     m_watchdogTimer = new QTimer(this);
-    m_watchdogTimer->setInterval(100); // Check every 100ms
+    m_watchdogTimer->setSingleShot(true);
+    m_watchdogTimer->setTimerType(Qt::PreciseTimer);
     connect(m_watchdogTimer, &QTimer::timeout, this, &SafetyMonitor::onWatchdogTick);
-    m_watchdogTimer->start();
 }
 
 double SafetyMonitor::clampVoltage(double v) const
@@ -53,7 +74,7 @@ void SafetyMonitor::updateAliveCounter(uint8_t counter)
 
     if (counter != m_lastAliveCounter) {
         m_lastAliveCounter = counter;
-        m_lastAliveTime = std::chrono::steady_clock::now();
+        armTimer(HeartbeatTimer, deadlineTick(std::chrono::steady_clock::now(), m_timeouts.heartbeatTimeoutMs));
         if (!m_heartbeatOk) {
             m_heartbeatOk = true;
             emit heartbeatRestored();
@@ -61,24 +82,57 @@ void SafetyMonitor::updateAliveCounter(uint8_t counter)
     }
 }
 
-void SafetyMonitor::messageReceived(uint32_t canId)
+void SafetyMonitor::setMonitoredMessages(const QVector<MonitoredMessage>& messages)
 {
-    m_messageTimestamps[canId] = {std::chrono::steady_clock::now(), false};
+    m_monitors.clear();
+    m_monitorIndex.clear();
+    m_monitors.reserve(messages.size());
+    for (const auto& message : messages) {
+        MessageMonitor monitor;
+        monitor.canId = message.canId;
+        monitor.name = message.name;
+        if (message.cycleTimeMs > 0) {
+            monitor.timeoutMs = static_cast<int>(std::lround(message.cycleTimeMs * m_timeouts.cycleTimeTolerance));
+            m_monitorIndex.insert(message.canId, m_monitors.size());
+        }
+        m_monitors.append(monitor);
+    }
+
+    // Keep the heartbeat deadline; the message deadlines start again from the next frame
+    const bool heartbeatArmed = m_wheel.isArmed(HeartbeatTimer);
+    const uint64_t heartbeatDeadline = m_wheel.deadline(HeartbeatTimer);
+    m_wheel.reset(static_cast<int>(m_monitors.size()) + 1, toTick(std::chrono::steady_clock::now()));
+    if (heartbeatArmed) m_wheel.arm(HeartbeatTimer, heartbeatDeadline);
+    scheduleWatchdog();
+}
+
+void SafetyMonitor::messageReceived(int messageIndex, std::chrono::steady_clock::time_point timestamp)
+{
+    if (messageIndex < 0 || messageIndex >= m_monitors.size()) return;
+    MessageMonitor& monitor = m_monitors[messageIndex];
+    if (monitor.timeoutMs == 0) return;
+
+    if (timestamp == std::chrono::steady_clock::time_point{}) {
+        timestamp = std::chrono::steady_clock::now(); // frame not stamped by a driver
+    }
+    monitor.timedOut = false;
+    armTimer(messageIndex + 1, deadlineTick(timestamp, monitor.timeoutMs));
 }
 
 bool SafetyMonitor::isMessageTimedOut(uint32_t canId) const
 {
-    auto it = m_messageTimestamps.find(canId);
-    if (it == m_messageTimestamps.end()) return true;
-    return it->timedOut;
+    const int index = m_monitorIndex.value(canId, -1);
+    if (index < 0) return true;
+    const MessageMonitor& monitor = m_monitors[index];
+    return monitor.timedOut || !m_wheel.isArmed(index + 1); // never received counts as timed out
 }
 
 void SafetyMonitor::triggerEmergencyStop(const QString& reason)
 {
     if (!m_emergencyStopped) {
         m_emergencyStopped = true;
+        emit emergencyStopTriggered(reason); // sends the safe state; log afterwards
         qWarning() << "EMERGENCY STOP:" << reason;
-        emit emergencyStopTriggered(reason);
     }
 }
 
@@ -90,27 +144,69 @@ void SafetyMonitor::clearEmergencyStop()
     }
 }
 
+void SafetyMonitor::setWatchdogTimerEnabled(bool enabled)
+{
+    m_watchdogEnabled = enabled;
+    if (enabled) {
+        scheduleWatchdog();
+    } else {
+        m_watchdogTimer->stop();
+        m_watchdogDueMs = TimerWheel::Never;
+    }
+}
+
 void SafetyMonitor::onWatchdogTick()
 {
-    auto now = std::chrono::steady_clock::now();
+    checkTimeouts();
+}
 
-    // Check heartbeat (AliveCounter)
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - m_lastAliveTime).count();
-    if (m_heartbeatOk && elapsed > m_timeouts.heartbeatTimeoutMs) {
-        m_heartbeatOk = false;
-        emit heartbeatLost();
+void SafetyMonitor::checkTimeouts()
+{
+    m_watchdogDueMs = TimerWheel::Never;
+    m_wheel.advance(toTick(std::chrono::steady_clock::now()), [this](int timer) { onTimerExpired(timer); });
+    scheduleWatchdog();
+}
+
+void SafetyMonitor::armTimer(int timer, uint64_t deadlineMs)
+{
+    if (m_wheel.empty()) {
+        // Idle since the last check: bring the wheel to now so it does not replay the gap
+        m_wheel.advance(toTick(std::chrono::steady_clock::now()), [](int) {});
     }
+    m_wheel.arm(timer, deadlineMs);
 
-    // Check message timeouts
-    for (auto it = m_messageTimestamps.begin(); it != m_messageTimestamps.end(); ++it) {
-        auto msgElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - it->lastSeen).count();
-        if (!it->timedOut && msgElapsed > m_timeouts.canMessageTimeoutMs) {
-            it->timedOut = true;
-            emit messageTimeout(it.key(), QString("0x%1").arg(it.key(), 4, 16, QChar('0')));
+    // A re-arm only moves a deadline later, so the watchdog is rarely restarted per frame
+    if (m_watchdogEnabled && deadlineMs < m_watchdogDueMs) scheduleWatchdog();
+}
+
+void SafetyMonitor::onTimerExpired(int timer)
+{
+    if (timer == HeartbeatTimer) {
+        if (m_heartbeatOk) {
+            m_heartbeatOk = false;
+            emit heartbeatLost();
         }
+        return;
+    }
+
+    MessageMonitor& monitor = m_monitors[timer - 1];
+    monitor.timedOut = true;
+    emit messageTimeout(monitor.canId, monitor.name);
+}
+
+void SafetyMonitor::scheduleWatchdog()
+{
+    if (!m_watchdogEnabled) return;
+
+    const uint64_t due = m_wheel.nextExpiry();
+    m_watchdogDueMs = due;
+    if (due == TimerWheel::Never) {
+        m_watchdogTimer->stop();
+        return;
     }
+    const uint64_t now = toTick(std::chrono::steady_clock::now());
+    const uint64_t delayMs = due > now ? due - now : 0;
+    m_watchdogTimer->start(static_cast<int>(std::min<uint64_t>(delayMs, std::numeric_limits<int>::max())));
 }
 
 QString SafetyMonitor::errorCodeDescription(uint16_t code)
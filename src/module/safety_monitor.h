@@ -1,9 +1,12 @@
 #pragma once
 
+#include "core/timer_wheel.h"
 #include "module/state_machine.h"
 #include <QObject>
 #include <QTimer>
-#include <QMap>
+#include <QHash>
+#include <QVector>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 
@@ -29,7 +32,7 @@ public:
 
     /// Timeout thresholds from datasheet
     struct Timeouts {
-        int canMessageTimeoutMs = 1000;     // 10 missed messages at 100ms
+        double cycleTimeTolerance = 10.0;   // message timeout = GenMsgCycleTime × this: 1000 ms at 100 ms
         int authenticationTimeoutS = 60;
         int parameterDiscoveryTimeoutS = 60;
         int cableCheckTimeoutS = 40;
@@ -55,10 +58,27 @@ public:
     void updateAliveCounter(uint8_t counter);
     bool isHeartbeatOk() const { return m_heartbeatOk; }
 
+    /// A received message the monitor may watch
+    struct MonitoredMessage {
+        uint32_t canId = 0;
+        QString name;
+        int cycleTimeMs = 0; // GenMsgCycleTime; 0 leaves the message unmonitored
+    };
+
     // CAN message timeout monitoring
-    void messageReceived(uint32_t canId);
+    /// One entry per DbcLayout message, in layout order. Replaces the previous set.
+    void setMonitoredMessages(const QVector<MonitoredMessage>& messages);
+    /// Called for every frame of a layout message: re-arms its deadline in O(1).
+    /// A message times out once it was received and then stays away for its timeout.
+    void messageReceived(int messageIndex, std::chrono::steady_clock::time_point timestamp);
     bool isMessageTimedOut(uint32_t canId) const;
 
+    /// Fires the heartbeat and message timeouts that are due. The watchdog timer
+    /// calls it at the next deadline; with the timer disabled the owner calls it
+    /// instead, and deadlines are met to the owner's calling interval.
+    void checkTimeouts();
+    void setWatchdogTimerEnabled(bool enabled);
+
     // Emergency stop
     void triggerEmergencyStop(const QString& reason);
     bool isEmergencyStopped() const { return m_emergencyStopped; }
@@ -80,23 +100,35 @@ private slots:
     void onWatchdogTick();
 
 private:
+    /// Wheel timer of the heartbeat; message i of the layout uses timer i + 1
+    static constexpr int HeartbeatTimer = 0;
+
+    void armTimer(int timer, uint64_t deadlineMs);
+    void onTimerExpired(int timer);
+    void scheduleWatchdog();
+
     Limits m_limits;
     Timeouts m_timeouts;
     QTimer* m_watchdogTimer = nullptr;
+    bool m_watchdogEnabled = true;
+    uint64_t m_watchdogDueMs = TimerWheel::Never; // when the watchdog timer fires next
 
     // Heartbeat tracking
     uint8_t m_lastAliveCounter = 15; // SNA
-    std::chrono::steady_clock::time_point m_lastAliveTime;
     bool m_heartbeatOk = false;
 
     // Message timeout tracking
-    struct MessageTimestamp {
-        std::chrono::steady_clock::time_point lastSeen;
+    struct MessageMonitor {
+        uint32_t canId = 0;
+        QString name;
+        int timeoutMs = 0; // 0: not monitored
         bool timedOut = false;
     };
-    QMap<uint32_t, MessageTimestamp> m_messageTimestamps;
+    QVector<MessageMonitor> m_monitors;     // by layout message index
+    QHash<uint32_t, int> m_monitorIndex;    // canId → m_monitors index, for queries
+    TimerWheel m_wheel;                     // all deadlines, in steady_clock milliseconds
 
-    bool m_emergencyStopped = false;
+    std::atomic<bool> m_emergencyStopped{false}; // read by the TX scheduler thread
 };
 
 } // namespace ccs
@@ -0,0 +1,189 @@
+#include "module/tx_scheduler.h"
+#include <QDebug>
+#include <QMutexLocker>
+#include <algorithm>
+#include <vector>
+
+#ifdef PLATFORM_LINUX
+#include <cerrno>
+#include <ctime>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+namespace ccs {
+
+TxScheduler::TxScheduler(QObject* parent)
+    : QThread(parent)
+{
+#ifdef PLATFORM_LINUX
+    // steady_clock is CLOCK_MONOTONIC, so its time points are valid timerfd deadlines
+    m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_timerFd < 0 || m_wakeFd < 0) {
+        qWarning() << "TxScheduler: timerfd/eventfd unavailable, falling back to clock_nanosleep";
+    }
+#endif
+}
+
+TxScheduler::~TxScheduler()
+{
+    stopScheduling();
+#ifdef PLATFORM_LINUX
+    if (m_timerFd >= 0) ::close(m_timerFd);
+    if (m_wakeFd >= 0) ::close(m_wakeFd);
+#endif
+}
+
+void TxScheduler::setEntries(const QVector<Entry>& entries)
+{
+    m_entries = entries;
+    for (auto& entry : m_entries) {
+        entry.periodMs = std::max(entry.periodMs, 1);
+        entry.phaseMs = std::max(entry.phaseMs, 0);
+    }
+}
+
+void TxScheduler::setSendFunction(SendFunction send)
+{
+    m_send = std::move(send);
+}
+
+void TxScheduler::startScheduling()
+{
+    if (m_running || !m_send) return;
+
+    {
+        QMutexLocker lock(&m_statsMutex);
+        m_stats = QVector<Statistics>(m_entries.size());
+    }
+
+#ifdef PLATFORM_LINUX
+    if (m_wakeFd >= 0) {
+        uint64_t pending;
+        while (::read(m_wakeFd, &pending, sizeof(pending)) > 0) {}
+    }
+#endif
+
+    m_running = true;
+    start(QThread::TimeCriticalPriority);
+}
+
+void TxScheduler::stopScheduling()
+{
+    if (!m_running) return;
+    m_running = false;
+    wake();
+    wait();
+}
+
+QVector<TxScheduler::Statistics> TxScheduler::statistics() const
+{
+    QMutexLocker lock(&m_statsMutex);
+    return m_stats;
+}
+
+// ─── Scheduler thread ────────────────────────────────────
+
+void TxScheduler::run()
+{
+    const int count = m_entries.size();
+    if (count == 0) return;
+
+    const auto start = Clock::now();
+    std::vector<Clock::time_point> deadlines(count);
+    for (int i = 0; i < count; ++i) {
+        deadlines[i] = start + std::chrono::milliseconds(m_entries[i].phaseMs);
+    }
+
+    while (m_running) {
+        if (!waitUntil(*std::min_element(deadlines.begin(), deadlines.end()))) break;
+
+        for (int i = 0; i < count; ++i) {
+            auto now = Clock::now();
+            if (deadlines[i] > now) continue;
+
+            auto lateness = now - deadlines[i];
+            m_send(i);
+
+            // A wake-up a full period late skips the overrun cycles instead of
+            // sending them back to back; each skipped deadline counts as a miss
+            const auto period = std::chrono::milliseconds(m_entries[i].periodMs);
+            const auto skipped = static_cast<uint64_t>(lateness / period);
+            deadlines[i] += period * (skipped + 1);
+
+            auto jitterUs = std::chrono::duration_cast<std::chrono::microseconds>(lateness).count();
+            QMutexLocker lock(&m_statsMutex);
+            Statistics& stats = m_stats[i];
+            ++stats.sent;
+            stats.missed += skipped;
+            stats.lastJitterUs = jitterUs;
+            stats.maxJitterUs = std::max(stats.maxJitterUs, jitterUs);
+            stats.meanJitterUs += (jitterUs - stats.meanJitterUs) / static_cast<double>(stats.sent);
+        }
+    }
+}
+
+bool TxScheduler::waitUntil(Clock::time_point deadline)
+{
+#ifdef PLATFORM_LINUX
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    timespec target{};
+    target.tv_sec = static_cast<time_t>(ns / 1000000000);
+    target.tv_nsec = static_cast<long>(ns % 1000000000);
+
+    if (m_timerFd >= 0 && m_wakeFd >= 0) {
+        itimerspec spec{};
+        spec.it_value = target;
+        if (timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+            // An unarmed timer would leave poll() waiting for wake() alone; sleep instead,
+            // this cycle and from now on
+            qWarning() << "TxScheduler: timerfd_settime failed, errno" << errno
+                       << "- falling back to clock_nanosleep";
+            ::close(m_timerFd);
+            m_timerFd = -1;
+        }
+    }
+    if (m_timerFd < 0 || m_wakeFd < 0) {
+        // Not interruptible: stopScheduling() waits out at most one sleep
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {}
+        return m_running;
+    }
+
+    pollfd fds[2] = {{m_timerFd, POLLIN, 0}, {m_wakeFd, POLLIN, 0}};
+    while (m_running) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            qWarning() << "TxScheduler: poll failed, errno" << errno;
+            return false;
+        }
+        if (fds[0].revents & POLLIN) {
+            uint64_t expirations;
+            (void)::read(m_timerFd, &expirations, sizeof(expirations));
+        }
+        break;
+    }
+    return m_running;
+#else
+    std::unique_lock lock(m_wakeMutex);
+    m_wakeCondition.wait_until(lock, deadline, [this] { return !m_running; });
+    return m_running;
+#endif
+}
+
+void TxScheduler::wake()
+{
+#ifdef PLATFORM_LINUX
+    if (m_wakeFd >= 0) {
+        uint64_t one = 1;
+        (void)::write(m_wakeFd, &one, sizeof(one));
+    }
+#else
+    { std::lock_guard lock(m_wakeMutex); }
+    m_wakeCondition.notify_all();
+#endif
+}
+
+} // namespace ccs
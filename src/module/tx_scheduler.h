@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#ifndef PLATFORM_LINUX
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace ccs {
+
+/// Sends cyclic CAN messages from a dedicated thread.
+/// Every entry has its own period and phase offset. The thread sleeps to absolute
+/// deadlines on the monotonic clock (timerfd on Linux), so a late wake-up delays one
+/// send but never shifts the cycles after it. Wake-up lateness is recorded per entry.
+class TxScheduler : public QThread {
+public:
+    struct Entry {
+        int periodMs = 100;
+        int phaseMs = 0;   // first send, relative to startScheduling()
+    };
+
+    /// Per-entry timing. Jitter is the lateness of a send against its deadline.
+    struct Statistics {
+        uint64_t sent = 0;
+        uint64_t missed = 0;         // deadlines passed without a send (woke a period or more late)
+        int64_t lastJitterUs = 0;
+        int64_t maxJitterUs = 0;
+        double meanJitterUs = 0.0;
+    };
+
+    /// Called on the scheduler thread with the index of the entry that is due
+    using SendFunction = std::function<void(int entry)>;
+
+    explicit TxScheduler(QObject* parent = nullptr);
+    ~TxScheduler() override;
+
+    /// Replace the schedule; takes effect on the next startScheduling()
+    void setEntries(const QVector<Entry>& entries);
+    void setSendFunction(SendFunction send);
+
+    /// Start the thread; statistics restart from zero
+    void startScheduling();
+    /// Stop the thread and wait for it; no send is in progress on return
+    void stopScheduling();
+    bool isScheduling() const { return m_running; }
+
+    QVector<Statistics> statistics() const;
+
+protected:
+    void run() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Sleep until deadline; false when woken by stopScheduling()
+    bool waitUntil(Clock::time_point deadline);
+    void wake();
+
+    QVector<Entry> m_entries;
+    SendFunction m_send;
+    std::atomic<bool> m_running{false};
+
+    mutable QMutex m_statsMutex;
+    QVector<Statistics> m_stats;
+
+#ifdef PLATFORM_LINUX
+    int m_timerFd = -1;
+    int m_wakeFd = -1;
+#else
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+#endif
+};
+
+} // namespace ccs
@@ -0,0 +1,151 @@
+#include "module/work_stealing_pool.h"
+#include <algorithm>
+
+namespace ccs {
+
+namespace {
+
+// Worker identity of the current thread, so a task's submits stay local
+thread_local const WorkStealingPool* t_pool = nullptr;
+thread_local int t_workerIndex = -1;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+{
+    if (threadCount <= 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    // Start only once every deque exists, as workers steal from all of them
+    for (int i = 0; i < threadCount; ++i) {
+        m_workers[i]->thread = std::thread([this, i] { run(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        worker->thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    const int count = threadCount();
+    int index = (t_pool == this) ? t_workerIndex
+                                 : static_cast<int>(m_nextWorker.fetch_add(1, std::memory_order_relaxed) % count);
+
+    ++m_unfinished;
+    {
+        Worker& worker = *m_workers[index];
+        std::lock_guard lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    ++m_queued;
+
+    // Taking the sleep mutex orders this submit against a worker that has just
+    // found nothing and is about to wait, so the notify cannot be lost
+    { std::lock_guard lock(m_sleepMutex); }
+    m_workAvailable.notify_one();
+}
+
+void WorkStealingPool::waitIdle()
+{
+    std::unique_lock lock(m_sleepMutex);
+    m_idle.wait(lock, [this] { return m_unfinished.load() == 0; });
+}
+
+WorkStealingPool::Statistics WorkStealingPool::statistics() const
+{
+    Statistics stats;
+    for (const auto& worker : m_workers) {
+        stats.executed += worker->executed.load(std::memory_order_relaxed);
+        stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+QVector<uint64_t> WorkStealingPool::workerLoad() const
+{
+    QVector<uint64_t> load;
+    for (const auto& worker : m_workers) {
+        load.append(worker->executed.load(std::memory_order_relaxed));
+    }
+    return load;
+}
+
+// ─── Worker threads ──────────────────────────────────────
+
+void WorkStealingPool::run(int index)
+{
+    t_pool = this;
+    t_workerIndex = index;
+    Worker& self = *m_workers[index];
+
+    for (;;) {
+        Task task;
+        if (popLocal(index, task)) {
+            // ran from own deque
+        } else if (steal(index, task)) {
+            self.stolen.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            std::unique_lock lock(m_sleepMutex);
+            m_workAvailable.wait(lock, [this] { return m_queued.load() > 0 || m_stopping; });
+            // Stop only once the deques are drained
+            if (m_stopping && m_queued.load() == 0) return;
+            continue;
+        }
+
+        task();
+        self.executed.fetch_add(1, std::memory_order_relaxed);
+        finished();
+    }
+}
+
+bool WorkStealingPool::popLocal(int index, Task& task)
+{
+    Worker& worker = *m_workers[index];
+    std::lock_guard lock(worker.mutex);
+    if (worker.tasks.empty()) return false;
+    // Newest first: its data is most likely still in this core's cache
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    --m_queued;
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, Task& task)
+{
+    const int count = threadCount();
+    for (int offset = 1; offset < count; ++offset) {
+        Worker& victim = *m_workers[(thief + offset) % count];
+        std::lock_guard lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        // Oldest first, from the end the owner does not work on
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --m_queued;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::finished()
+{
+    if (--m_unfinished == 0) {
+        { std::lock_guard lock(m_sleepMutex); }
+        m_idle.notify_all();
+    }
+}
+
+} // namespace ccs
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccs {
+
+/// Fixed set of worker threads, each with its own task deque.
+/// A worker runs its own tasks newest first and, when it runs dry, steals the
+/// oldest task of another worker. Tasks submitted from outside the pool are dealt
+/// round-robin; tasks submitted by a worker stay on that worker.
+///
+/// Tasks of the pool run in no particular order and may run concurrently with
+/// each other; callers serialise what must not overlap.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    struct Statistics {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;   // of executed, run by a worker other than the one queued on
+    };
+
+    /// threadCount 0 uses one worker per hardware thread
+    explicit WorkStealingPool(int threadCount = 0);
+    /// Runs the tasks still queued, then joins the workers
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+
+    /// Block until every submitted task has finished, including tasks they submit
+    void waitIdle();
+
+    int threadCount() const { return static_cast<int>(m_workers.size()); }
+    Statistics statistics() const;
+    /// Executed tasks per worker
+    QVector<uint64_t> workerLoad() const;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+    };
+
+    void run(int index);
+    bool popLocal(int index, Task& task);
+    bool steal(int thief, Task& task);
+    void finished();
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<uint32_t> m_nextWorker{0};
+
+    std::atomic<int64_t> m_queued{0};    // in a deque
+    std::atomic<int64_t> m_unfinished{0}; // queued or running
+    std::atomic<bool> m_stopping{false};
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_idle;
+};
+
+} // namespace ccs
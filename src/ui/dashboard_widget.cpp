@@ -6,6 +6,8 @@
 #include <QScrollArea>
 #include <QFrame>
 #include <QTime>
+#include <QTimer>
+#include <algorithm>
 
 namespace ccs {
 
@@ -20,7 +22,7 @@ void DashboardWidget::setChargeModule(ChargeModule* module)
     m_module = module;
 
     if (m_module) {
-        connect(m_module, &ChargeModule::evseDataUpdated, this, &DashboardWidget::updateDisplay);
+        connect(m_module, &ChargeModule::evseDataChanged, this, &DashboardWidget::updateDisplay);
 
         // Wire controls to module
         connect(m_startBtn, &QPushButton::clicked, this, &DashboardWidget::startChargingRequested);
@@ -82,6 +84,10 @@ void DashboardWidget::setupUi()
     midLayout->addWidget(createFaultPanel(), 1);
 
     mainLayout->addLayout(midLayout, 1);
+
+    auto* staleTimer = new QTimer(this);
+    connect(staleTimer, &QTimer::timeout, this, &DashboardWidget::updateStaleness);
+    staleTimer->start(StaleCheckIntervalMs);
 }
 
 QWidget* DashboardWidget::createValueCard(const QString& title, QLabel** valueLabel, QLabel** unitLabel, const QColor& accent)
@@ -145,6 +151,7 @@ QGroupBox* DashboardWidget::createInfoPanel()
     addRow("EVSE Status", &m_evseStatusLabel);
     addRow("Compatible", &m_compatLabel);
     addRow("Voltage Match", &m_voltMatchLabel);
+    addRow("EVSE Data", &m_dataAgeLabel);
 
     layout->addWidget(new QLabel(""), row, 0); // spacer
     row++;
@@ -241,77 +248,103 @@ QGroupBox* DashboardWidget::createFaultPanel()
     return group;
 }
 
-void DashboardWidget::updateDisplay()
+void DashboardWidget::updateDisplay(ChargeModule::EvseFieldMask changed)
 {
     if (!m_module) return;
 
-    const auto& evse = m_module->evseData();
+    using F = ChargeModule::EvseField;
+    auto has = [changed](auto... fields) { return (changed & (ChargeModule::fieldBit(fields) | ...)) != 0; };
+
+    const auto evse = m_module->evseSnapshot();
+    const double soc = m_module->evParamsSnapshot().evSoC;
 
     // Big value cards
-    updateValueCard(m_voltageValue, m_voltageUnit, evse.evsePresentVoltage, "V");
-    updateValueCard(m_currentValue, m_currentUnit, evse.evsePresentCurrent, "A");
-    double power = evse.evsePresentVoltage * evse.evsePresentCurrent;
-    if (power > 1000.0)
-        updateValueCard(m_powerValue, m_powerUnit, power / 1000.0, "kW", 2);
-    else
-        updateValueCard(m_powerValue, m_powerUnit, power, "W", 0);
+    if (has(F::EvsePresentVoltage, F::EvsePresentCurrent)) {
+        updateValueCard(m_voltageValue, m_voltageUnit, evse.evsePresentVoltage, "V");
+        updateValueCard(m_currentValue, m_currentUnit, evse.evsePresentCurrent, "A");
+        double power = evse.evsePresentVoltage * evse.evsePresentCurrent;
+        if (power > 1000.0)
+            updateValueCard(m_powerValue, m_powerUnit, power / 1000.0, "kW", 2);
+        else
+            updateValueCard(m_powerValue, m_powerUnit, power, "W", 0);
+    }
 
-    updateValueCard(m_socValue, m_socUnit, m_module->evParams().evSoC, "%");
-    m_socBar->setValue(static_cast<int>(m_module->evParams().evSoC));
+    if (soc != m_shownSoC) {
+        m_shownSoC = soc;
+        updateValueCard(m_socValue, m_socUnit, soc, "%");
+        m_socBar->setValue(static_cast<int>(soc));
+    }
 
     // State info
-    m_stateLabel->setText(cmsStateToString(evse.stateMachineState));
-
-    // Color code the state
-    QColor stateColor = Theme::TextPrimary;
-    switch (evse.stateMachineState) {
-        case CmsState::Charge:    stateColor = Theme::AccentGreen; break;
-        case CmsState::PreCharge: stateColor = Theme::AccentCyan; break;
-        case CmsState::Error:     stateColor = Theme::AccentRed; break;
-        case CmsState::StopCharge:
-        case CmsState::SessionStop:
-        case CmsState::ShutOff:   stateColor = Theme::AccentOrange; break;
-        default: break;
+    if (has(F::StateMachineState)) {
+        m_stateLabel->setText(cmsStateToString(evse.stateMachineState));
+
+        // Color code the state
+        QColor stateColor = Theme::TextPrimary;
+        switch (evse.stateMachineState) {
+            case CmsState::Charge:    stateColor = Theme::AccentGreen; break;
+            case CmsState::PreCharge: stateColor = Theme::AccentCyan; break;
+            case CmsState::Error:     stateColor = Theme::AccentRed; break;
+            case CmsState::StopCharge:
+            case CmsState::SessionStop:
+            case CmsState::ShutOff:   stateColor = Theme::AccentOrange; break;
+            default: break;
+        }
+        m_stateLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;").arg(stateColor.name()));
     }
-    m_stateLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;").arg(stateColor.name()));
 
     // Protocol
-    const char* protoNames[] = {"Not Defined", "DIN 70121", "ISO 15118", "Not Supported"};
-    int protoIdx = static_cast<int>(evse.actualChargeProtocol);
-    m_protocolLabel->setText(protoIdx < 4 ? protoNames[protoIdx] : "SNA");
+    if (has(F::ActualChargeProtocol)) {
+        const char* protoNames[] = {"Not Defined", "DIN 70121", "ISO 15118", "Not Supported"};
+        int protoIdx = static_cast<int>(evse.actualChargeProtocol);
+        m_protocolLabel->setText(protoIdx < 4 ? protoNames[protoIdx] : "SNA");
+    }
 
     // Control Pilot
-    const char* cpNames[] = {"A", "B", "C", "D", "E", "F"};
-    int cpIdx = static_cast<int>(evse.controlPilotState);
-    m_pilotStateLabel->setText(cpIdx < 6 ? cpNames[cpIdx] : "SNA");
+    if (has(F::ControlPilotState)) {
+        const char* cpNames[] = {"A", "B", "C", "D", "E", "F"};
+        int cpIdx = static_cast<int>(evse.controlPilotState);
+        m_pilotStateLabel->setText(cpIdx < 6 ? cpNames[cpIdx] : "SNA");
+    }
 
     // Isolation
-    const char* isoNames[] = {"Invalid", "Valid", "Warning", "Fault", "No IMD", "Checking"};
-    int isoIdx = static_cast<int>(evse.evseIsolationStatus);
-    m_isolationLabel->setText(isoIdx < 6 ? isoNames[isoIdx] : "SNA");
-    QColor isoColor = (isoIdx == 1) ? Theme::AccentGreen : (isoIdx == 3) ? Theme::AccentRed : Theme::TextPrimary;
-    m_isolationLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;").arg(isoColor.name()));
+    if (has(F::EvseIsolationStatus)) {
+        const char* isoNames[] = {"Invalid", "Valid", "Warning", "Fault", "No IMD", "Checking"};
+        int isoIdx = static_cast<int>(evse.evseIsolationStatus);
+        m_isolationLabel->setText(isoIdx < 6 ? isoNames[isoIdx] : "SNA");
+        QColor isoColor = (isoIdx == 1) ? Theme::AccentGreen : (isoIdx == 3) ? Theme::AccentRed : Theme::TextPrimary;
+        m_isolationLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;").arg(isoColor.name()));
+    }
 
     // EVSE Status
-    const char* statusNames[] = {"Not Ready", "Ready", "Shutdown", "Utility Interrupt", "Isolation Active", "Emergency", "Malfunction"};
-    int stIdx = static_cast<int>(evse.evseStatusCode);
-    m_evseStatusLabel->setText(stIdx < 7 ? statusNames[stIdx] : "SNA");
+    if (has(F::EvseStatusCode)) {
+        const char* statusNames[] = {"Not Ready", "Ready", "Shutdown", "Utility Interrupt", "Isolation Active", "Emergency", "Malfunction"};
+        int stIdx = static_cast<int>(evse.evseStatusCode);
+        m_evseStatusLabel->setText(stIdx < 7 ? statusNames[stIdx] : "SNA");
+    }
 
     // Compatible & VoltageMatch
-    m_compatLabel->setText(evse.evseCompatible ? "Yes" : "No");
-    m_compatLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;")
-        .arg(evse.evseCompatible ? Theme::AccentGreen.name() : Theme::AccentRed.name()));
-    m_voltMatchLabel->setText(evse.voltageMatch ? "Yes" : "No");
-    m_voltMatchLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;")
-        .arg(evse.voltageMatch ? Theme::AccentGreen.name() : Theme::TextSecondary.name()));
+    if (has(F::EvseCompatible)) {
+        m_compatLabel->setText(evse.evseCompatible ? "Yes" : "No");
+        m_compatLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;")
+            .arg(evse.evseCompatible ? Theme::AccentGreen.name() : Theme::AccentRed.name()));
+    }
+    if (has(F::VoltageMatch)) {
+        m_voltMatchLabel->setText(evse.voltageMatch ? "Yes" : "No");
+        m_voltMatchLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;")
+            .arg(evse.voltageMatch ? Theme::AccentGreen.name() : Theme::TextSecondary.name()));
+    }
 
     // EVSE limits
-    m_evseMaxVLabel->setText(QString("%1 V").arg(evse.evseMaxVoltage, 0, 'f', 1));
-    m_evseMaxILabel->setText(QString("%1 A").arg(evse.evseMaxCurrent, 0, 'f', 1));
-    m_evseMaxPLabel->setText(QString("%1 kW").arg(evse.evseMaxPower / 1000.0, 0, 'f', 1));
+    if (has(F::EvseMaxVoltage))
+        m_evseMaxVLabel->setText(QString("%1 V").arg(evse.evseMaxVoltage, 0, 'f', 1));
+    if (has(F::EvseMaxCurrent))
+        m_evseMaxILabel->setText(QString("%1 A").arg(evse.evseMaxCurrent, 0, 'f', 1));
+    if (has(F::EvseMaxPower))
+        m_evseMaxPLabel->setText(QString("%1 kW").arg(evse.evseMaxPower / 1000.0, 0, 'f', 1));
 
     // Error codes
-    if (evse.errorCode0 > 1) {
+    if (has(F::ErrorCode0) && evse.errorCode0 > 1) {
         QString errMsg = QString("[%1] Error 0x%2: %3")
             .arg(QTime::currentTime().toString("hh:mm:ss"))
             .arg(evse.errorCode0, 4, 16, QChar('0'))
@@ -328,6 +361,45 @@ void DashboardWidget::updateDisplay()
     }
 }
 
+void DashboardWidget::updateStaleness()
+{
+    if (!m_module) return;
+
+    using F = ChargeModule::EvseField;
+    const auto now = ChargeModule::Clock::now();
+    constexpr auto presentValues = ChargeModule::fieldBit(F::EvsePresentVoltage)
+                                 | ChargeModule::fieldBit(F::EvsePresentCurrent);
+    const bool presentStale = m_module->staleFields(presentValues, ChargeModule::DefaultMaxAge, now) != 0;
+
+    if (presentStale != m_presentStale) {
+        m_presentStale = presentStale;
+        const QColor color = presentStale ? Theme::TextDisabled : Theme::TextPrimary;
+        for (QLabel* value : {m_voltageValue, m_currentValue, m_powerValue}) {
+            value->setStyleSheet(QString("color: %1; font-size: 36px; font-weight: bold;").arg(color.name()));
+            value->setToolTip(presentStale ? "Stale: EVSEDCStatus is not being received" : QString());
+        }
+    }
+
+    // Oldest of the live values on display: present values and the CMS state
+    const auto age = std::max({m_module->age(F::EvsePresentVoltage, now),
+                               m_module->age(F::EvsePresentCurrent, now),
+                               m_module->age(F::StateMachineState, now)});
+    QString text = "Live";
+    QColor color = Theme::AccentGreen;
+    if (age == ChargeModule::Clock::duration::max()) {
+        text = "No data";
+        color = Theme::TextSecondary;
+    } else if (age > ChargeModule::DefaultMaxAge) {
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(age).count();
+        text = QString("Stale (%1 s)").arg(ms / 1000.0, 0, 'f', 1);
+        color = Theme::AccentOrange;
+    }
+    if (m_dataAgeLabel->text() != text) {
+        m_dataAgeLabel->setText(text);
+        m_dataAgeLabel->setStyleSheet(QString("color: %1; font-size: 12px; font-weight: bold;").arg(color.name()));
+    }
+}
+
 void DashboardWidget::updateValueCard(QLabel* value, QLabel* unit, double val, const QString& unitStr, int decimals)
 {
     value->setText(QString::number(val, 'f', decimals));
@@ -17,7 +17,8 @@ public:
     explicit DashboardWidget(QWidget* parent = nullptr);
 
     void setChargeModule(ChargeModule* module);
-    void updateDisplay();
+    /// Refresh the labels whose fields are set in changed
+    void updateDisplay(ChargeModule::EvseFieldMask changed = ~ChargeModule::EvseFieldMask{0});
 
 signals:
     void startChargingRequested();
@@ -33,6 +34,8 @@ private:
     QGroupBox* createInfoPanel();
     QGroupBox* createFaultPanel();
     void updateValueCard(QLabel* value, QLabel* unit, double val, const QString& unitStr, int decimals = 1);
+    /// Grey out values whose frames stopped arriving; they raise no evseDataChanged()
+    void updateStaleness();
 
     ChargeModule* m_module = nullptr;
 
@@ -54,6 +57,7 @@ private:
     QLabel* m_evseStatusLabel = nullptr;
     QLabel* m_compatLabel = nullptr;
     QLabel* m_voltMatchLabel = nullptr;
+    QLabel* m_dataAgeLabel = nullptr;
 
     // EVSE limits
     QLabel* m_evseMaxVLabel = nullptr;
@@ -78,6 +82,10 @@ private:
 
     // SoC progress bar
     QProgressBar* m_socBar = nullptr;
+    double m_shownSoC = -1.0; // SoC is an EV parameter, so it has no change bit
+
+    bool m_presentStale = false; // value cards shown greyed out
+    static constexpr int StaleCheckIntervalMs = 250;
 };
 
 } // namespace ccs
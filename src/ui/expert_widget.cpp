@@ -6,6 +6,7 @@
 #include <QHeaderView>
 #include <QLabel>
 #include <QDateTime>
+#include <QTimer>
 
 namespace ccs {
 
@@ -21,7 +22,15 @@ void ExpertWidget::setChargeModule(ChargeModule* module)
     if (m_module) {
         connect(m_module, &ChargeModule::rawFrameReceived, this, &ExpertWidget::onRawFrameReceived);
         connect(m_module, &ChargeModule::rawFrameSent, this, &ExpertWidget::onRawFrameSent);
-        connect(m_module, &ChargeModule::evseDataUpdated, this, &ExpertWidget::onDecodedUpdate);
+        connect(m_module, &ChargeModule::evseDataChanged, this, &ExpertWidget::onDecodedUpdate);
+    }
+}
+
+void ExpertWidget::onRefreshTick()
+{
+    // Messages without EvseData fields raise no evseDataChanged(); poll the table for them
+    if (m_module && m_module->signalTable().sequence() != m_shownSequence) {
+        refreshDecoded();
     }
 }
 
@@ -104,6 +113,10 @@ void ExpertWidget::setupUi()
     splitter->setStretchFactor(1, 1);
 
     mainLayout->addWidget(splitter);
+
+    auto* refreshTimer = new QTimer(this);
+    connect(refreshTimer, &QTimer::timeout, this, &ExpertWidget::onRefreshTick);
+    refreshTimer->start(RefreshIntervalMs);
 }
 
 void ExpertWidget::addRawRow(const QString& dir, const CanFrame& frame)
@@ -125,10 +138,10 @@ void ExpertWidget::addRawRow(const QString& dir, const CanFrame& frame)
 
     setItem(0, QTime::currentTime().toString("hh:mm:ss.zzz"), Theme::TextSecondary);
     setItem(1, dir, dir == "TX" ? Theme::AccentGreen : Theme::AccentCyan);
-    setItem(2, "0x" + frame.idString(), Theme::AccentCyan);
+    setItem(2, "0x" + frameIdString(frame), Theme::AccentCyan);
     setItem(3, frame.extended ? "EXT" : "STD", Theme::TextSecondary);
     setItem(4, QString::number(frame.dlc), Theme::TextSecondary);
-    setItem(5, frame.toHexString(), Theme::TextPrimary);
+    setItem(5, frameHexString(frame), Theme::TextPrimary);
 
     m_rawRowCount++;
 
@@ -147,12 +160,19 @@ void ExpertWidget::onRawFrameSent(const CanFrame& frame)
     addRawRow("TX", frame);
 }
 
-void ExpertWidget::onDecodedUpdate()
+void ExpertWidget::onDecodedUpdate(ChargeModule::EvseFieldMask)
+{
+    refreshDecoded();
+}
+
+void ExpertWidget::refreshDecoded()
 {
     if (!m_module) return;
 
-    const auto& evse = m_module->evseData();
-    const auto& ev = m_module->evParams();
+    const SignalTable& table = m_module->signalTable();
+    m_shownSequence = table.sequence();
+    const DbcDatabase& db = m_module->dbcDatabase();
+    const auto ev = m_module->evParamsSnapshot();
 
     // Build a flat list of all known signal values
     struct SigRow {
@@ -173,29 +193,17 @@ void ExpertWidget::onDecodedUpdate()
         rows.append({msg, sig, desc, QString::number(raw), ""});
     };
 
-    // ChargeInfo
-    addRowEnum("ChargeInfo", "StateMachineState", static_cast<int>(evse.stateMachineState), cmsStateToString(evse.stateMachineState));
-    addRowEnum("ChargeInfo", "AliveCounter", evse.aliveCounter, "");
-    addRowEnum("ChargeInfo", "ControlPilotState", static_cast<int>(evse.controlPilotState), "");
-    addRow("ChargeInfo", "ControlPilotDutyCycle", evse.controlPilotDutyCycle, "%");
-    addRowEnum("ChargeInfo", "ActualChargeProtocol", static_cast<int>(evse.actualChargeProtocol), "");
-    addRowEnum("ChargeInfo", "VoltageMatch", evse.voltageMatch ? 1 : 0, evse.voltageMatch ? "True" : "False");
-    addRowEnum("ChargeInfo", "EVSECompatible", evse.evseCompatible ? 1 : 0, evse.evseCompatible ? "True" : "False");
-    addRowEnum("ChargeInfo", "TCPStatus", evse.tcpConnected ? 1 : 0, evse.tcpConnected ? "Connected" : "Not Connected");
-
-    // EVSEDCStatus
-    addRow("EVSEDCStatus", "EVSEPresentVoltage", evse.evsePresentVoltage, "V");
-    addRow("EVSEDCStatus", "EVSEPresentCurrent", evse.evsePresentCurrent, "A");
-    addRowEnum("EVSEDCStatus", "EVSEIsolationStatus", static_cast<int>(evse.evseIsolationStatus), "");
-    addRowEnum("EVSEDCStatus", "EVSEStatusCode", static_cast<int>(evse.evseStatusCode), "");
-
-    // EVSEDCMaxLimits
-    addRow("EVSEDCMaxLimits", "EVSEMaxVoltage", evse.evseMaxVoltage, "V");
-    addRow("EVSEDCMaxLimits", "EVSEMaxCurrent", evse.evseMaxCurrent, "A");
-    addRow("EVSEDCMaxLimits", "EVSEMaxPower", evse.evseMaxPower, "W");
-
-    // ErrorCodes
-    addRowEnum("ErrorCodes", "ErrorCodeLevel0", evse.errorCode0, SafetyMonitor::errorCodeDescription(evse.errorCode0));
+    // Every signal received so far, in DBC order
+    for (int handle = 0; handle < table.size(); ++handle) {
+        const SignalTable::Value value = table.value(handle);
+        if (value.sequence == 0) continue;
+        const DbcMessage* msg = db.messageByHandle(handle);
+        const DbcSignal* sig = db.signalByHandle(handle);
+        if (!msg || !sig) continue;
+        rows.append({msg->name, sig->name,
+                     value.valid ? QString("%1 %2").arg(value.physical, 0, 'f', 2).arg(sig->unit) : QString("SNA"),
+                     QString::number(value.raw), db.valueText(*sig, value.raw)});
+    }
 
     // EV Parameters (our output)
     addRow("EVDCMaxLimits", "EVMaxVoltage", ev.evMaxVoltage, "V");
@@ -208,10 +216,19 @@ void ExpertWidget::onDecodedUpdate()
     addRowEnum("EVStatusControl", "ChargeStopIndication", static_cast<int>(ev.chargeStop), "");
     addRow("EVStatusDisplay", "EVSoC", ev.evSoC, "%");
 
-    // Populate table
-    m_decodedTable->setRowCount(rows.size());
+    // Populate table. The row layout is fixed, so items are created once and later
+    // updates only touch cells whose text changed.
+    const bool create = m_decodedTable->rowCount() != rows.size();
+    if (create) {
+        m_decodedTable->setRowCount(rows.size());
+    }
     for (int i = 0; i < rows.size(); ++i) {
         auto setItem = [&](int col, const QString& text, const QColor& color = Theme::TextPrimary) {
+            if (!create) {
+                auto* item = m_decodedTable->item(i, col);
+                if (item->text() != text) item->setText(text);
+                return;
+            }
             auto* item = new QTableWidgetItem(text);
             item->setForeground(color);
             m_decodedTable->setItem(i, col, item);
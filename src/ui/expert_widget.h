@@ -22,11 +22,13 @@ public:
 public slots:
     void onRawFrameReceived(const ccs::CanFrame& frame);
     void onRawFrameSent(const ccs::CanFrame& frame);
-    void onDecodedUpdate();
+    void onDecodedUpdate(ccs::ChargeModule::EvseFieldMask changed);
 
 private:
     void setupUi();
     void addRawRow(const QString& dir, const CanFrame& frame);
+    void refreshDecoded();
+    void onRefreshTick();
 
     ChargeModule* m_module = nullptr;
 
@@ -37,6 +39,8 @@ private:
 
     // Decoded signals table
     QTableWidget* m_decodedTable = nullptr;
+    uint64_t m_shownSequence = 0; // SignalTable::sequence() the table shows
+    static constexpr int RefreshIntervalMs = 250;
 
     int m_rawRowCount = 0;
     static constexpr int MAX_RAW_ROWS = 5000;
@@ -12,6 +12,7 @@
 #include <QStandardPaths>
 #include <QDateTime>
 #include <QDebug>
+#include <algorithm>
 
 namespace ccs {
 
@@ -25,8 +26,13 @@ MainWindow::MainWindow(QWidget* parent)
     // Apply theme
     qApp->setStyleSheet(Theme::globalStyleSheet());
 
-    // Create core objects
-    m_module = new ChargeModule(this);
+    // Create core objects. The protocol core (RX decode, safety watchdog) runs on its
+    // own thread so menus, chart redraws and the expert table cannot delay it.
+    m_moduleThread = new QThread(this);
+    m_moduleThread->setObjectName("ChargeModule");
+    m_module = new ChargeModule;
+    m_module->moveToThread(m_moduleThread);
+    m_moduleThread->start();
     m_pcanDriver = new PcanDriver(this);
     m_simInterface = new SimulatedCanInterface(this);
     m_logger = new CanLogger(this);
@@ -67,6 +73,12 @@ MainWindow::~MainWindow()
         m_canInterface->close();
     }
     m_logger->stopAll();
+
+    // The module's timers belong to its thread: delete it there, then stop the thread
+    QMetaObject::invokeMethod(m_module, [this] { delete m_module; }, Qt::BlockingQueuedConnection);
+    m_module = nullptr;
+    m_moduleThread->quit();
+    m_moduleThread->wait();
 }
 
 void MainWindow::setupUi()
@@ -132,6 +144,11 @@ void MainWindow::setupMenuBar()
         if (!path.isEmpty()) {
             m_dbcPath = path;
             m_module->loadDbc(m_dbcPath);
+            if (!m_module->bindingWarnings().isEmpty()) {
+                QMessageBox::warning(this, "DBC Signals Missing",
+                    "The DBC lacks signals the charge module uses; they will not be sent or decoded:\n\n"
+                    + m_module->bindingWarnings().join("\n"));
+            }
         }
     });
     fileMenu->addAction(loadDbcAction);
@@ -176,6 +193,17 @@ void MainWindow::setupMenuBar()
     });
     fileMenu->addAction(saveReportAction);
 
+    auto* exportLatencyAction = new QAction("Export &Latency Histograms...", this);
+    connect(exportLatencyAction, &QAction::triggered, this, [this]() {
+        QString dir = QFileDialog::getExistingDirectory(this, "Export Latency Histograms");
+        if (dir.isEmpty()) return;
+        QString error;
+        if (!m_module->latencyTrace()->exportHistograms(dir, &error)) {
+            QMessageBox::warning(this, "Export Failed", error);
+        }
+    });
+    fileMenu->addAction(exportLatencyAction);
+
     fileMenu->addSeparator();
 
     auto* exitAction = new QAction("E&xit", this);
@@ -310,14 +338,12 @@ void MainWindow::onConnect()
         connect(m_module, &ChargeModule::rawFrameReceived, this, [this]() { m_rxFrameCount++; });
         connect(m_module, &ChargeModule::rawFrameSent, this, [this]() { m_txFrameCount++; });
 
-        // Update chart from EVSE data
-        connect(m_module, &ChargeModule::evseDataUpdated, this, [this]() {
-            const auto& evse = m_module->evseData();
-            m_chartWidget->addDataPoint(evse.evsePresentVoltage, evse.evsePresentCurrent);
-
-            // Update session report
-            if (m_sessionReport->isActive()) {
-                m_sessionReport->updateValues(evse.evsePresentVoltage, evse.evsePresentCurrent, m_module->evParams().evSoC);
+        // Update chart from EVSE data; onStatusUpdate() fills in while the values hold steady
+        connect(m_module, &ChargeModule::evseDataChanged, this, [this](ChargeModule::EvseFieldMask changed) {
+            constexpr auto presentValues = ChargeModule::fieldBit(ChargeModule::EvseField::EvsePresentVoltage)
+                                         | ChargeModule::fieldBit(ChargeModule::EvseField::EvsePresentCurrent);
+            if (changed & presentValues) {
+                sampleEvse();
             }
         });
 
@@ -409,8 +435,8 @@ void MainWindow::onStateChanged(CmsState state)
     // Auto-actions based on state transitions per datasheet
     switch (state) {
         case CmsState::PreCharge:
-            // Per datasheet: TargetCurrent fixed at 2A during PreCharge
-            m_module->setEvTargetCurrent(2.0);
+            // The module's sequencer has already fixed TargetCurrent at 2A and will send
+            // ChargeProgressIndication=Start once VoltageMatch is reported
             statusBar()->showMessage("PreCharge: Target current set to 2A per datasheet", 3000);
             break;
 
@@ -439,10 +465,34 @@ void MainWindow::onErrorCode(uint16_t code, const QString& desc)
     statusBar()->showMessage(QString("Error 0x%1: %2").arg(code, 4, 16, QChar('0')).arg(desc), 10000);
 }
 
+void MainWindow::sampleEvse()
+{
+    const auto evse = m_module->evseSnapshot();
+    const bool fresh = m_module->isFresh(ChargeModule::EvseField::EvsePresentVoltage)
+                    && m_module->isFresh(ChargeModule::EvseField::EvsePresentCurrent);
+    if (fresh) {
+        m_chartWidget->addDataPoint(evse.evsePresentVoltage, evse.evsePresentCurrent);
+    }
+
+    // Update session report
+    if (m_sessionReport->isActive()) {
+        m_sessionReport->updateValues(evse.evsePresentVoltage, evse.evsePresentCurrent,
+                                      m_module->evParamsSnapshot().evSoC, fresh);
+    }
+}
+
 void MainWindow::onStatusUpdate()
 {
-    // Update frame counts
-    m_statusFrames->setText(QString("RX: %1 | TX: %2").arg(m_rxFrameCount).arg(m_txFrameCount));
+    // Update frame counts and TX timing
+    uint64_t txMissed = 0;
+    int64_t txMaxJitterUs = 0;
+    for (const auto& stats : m_module->txStatistics()) {
+        txMissed += stats.missed;
+        txMaxJitterUs = std::max(txMaxJitterUs, stats.maxJitterUs);
+    }
+    m_statusFrames->setText(QString("RX: %1 | TX: %2 | Decode skipped: %3 | TX jitter max: %4 ms | TX missed: %5")
+        .arg(m_rxFrameCount).arg(m_txFrameCount).arg(m_module->rxDecodeSavedCount())
+        .arg(txMaxJitterUs / 1000.0, 0, 'f', 1).arg(txMissed));
 
     // Update session info
     if (m_sessionReport->isActive()) {
@@ -457,8 +507,12 @@ void MainWindow::onStatusUpdate()
     if (m_canInterface && m_canInterface->isOpen()) {
         m_connectionWidget->setStatus(m_canInterface->status());
 
+        // evseDataChanged() is silent while nothing changes, so sample the chart and
+        // session energy here too to keep both continuous
+        sampleEvse();
+
         // Update module firmware version
-        const auto& evse = m_module->evseData();
+        const auto evse = m_module->evseSnapshot();
         if (evse.swVersionMajor > 0 || evse.swVersionMinor > 0) {
             m_connectionWidget->setModuleInfo(QString("FW %1.%2.%3 (Config %4)")
                 .arg(evse.swVersionMajor)
@@ -14,6 +14,7 @@
 #include <QTabWidget>
 #include <QStatusBar>
 #include <QLabel>
+#include <QThread>
 #include <QTimer>
 
 namespace ccs {
@@ -41,9 +42,11 @@ private:
     void setupMenuBar();
     void setupStatusBar();
     void initModule();
+    void sampleEvse();
 
     // Core
     ChargeModule* m_module = nullptr;
+    QThread* m_moduleThread = nullptr;
     CanInterface* m_canInterface = nullptr;
     PcanDriver* m_pcanDriver = nullptr;
     SimulatedCanInterface* m_simInterface = nullptr;
@@ -0,0 +1,175 @@
+#include "dbc/dbc_parser.h"
+#include "dbc/signal_codec.h"
+#include <QtTest>
+#include <algorithm>
+#include <cmath>
+
+using namespace ccs;
+
+namespace {
+
+// Even fixed factors put a half step on an integer in scaled units: the ties where
+// a double division lands a hair below .5
+const char* const TieDbc = R"(VERSION ""
+
+BU_: CMS
+
+BO_ 256 Ties: 8 CMS
+ SG_ Fifth : 0|8@1+ (0.2,0) [0|51] "A" CMS
+ SG_ SignedOffset : 8|12@1- (0.02,-3.1) [-44|38] "V" CMS
+ SG_ Motorola : 31|16@0+ (0.5,-100) [-100|32667.5] "kW" CMS
+ SG_ Narrow : 40|8@1- (2,1) [-1000|1000] "" CMS
+)";
+
+// Enumerate raw values up to this many per signal; wider signals are walked with an
+// even stride from one end of their range to the other
+constexpr uint64_t MaxRawSteps = uint64_t{1} << 20;
+
+} // namespace
+
+class TestSignalCodec : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void fixedMatchesDouble_data();
+    void fixedMatchesDouble();
+    void halfStepTie();
+    void signedSaturation();
+
+private:
+    DbcDatabase m_shipped;
+    DbcDatabase m_ties;
+};
+
+void TestSignalCodec::initTestCase()
+{
+    DbcParser shipped;
+    QVERIFY2(shipped.parse(CCS_TEST_DBC), qPrintable(shipped.lastError()));
+    m_shipped = shipped.database();
+
+    DbcParser ties;
+    QVERIFY2(ties.parseText(TieDbc), qPrintable(ties.lastError()));
+    m_ties = ties.database();
+}
+
+void TestSignalCodec::fixedMatchesDouble_data()
+{
+    QTest::addColumn<bool>("ties");
+    QTest::addColumn<uint32_t>("canId");
+    QTest::addColumn<int>("signalIndex");
+
+    for (const bool ties : {false, true}) {
+        const DbcDatabase& db = ties ? m_ties : m_shipped;
+        for (auto it = db.messages.cbegin(); it != db.messages.cend(); ++it) {
+            const auto& dbcSignals = it.value().dbcSignals;
+            for (int i = 0; i < dbcSignals.size(); ++i) {
+                if (!dbcSignals[i].fixedPointExact) continue;
+                QTest::newRow(qPrintable(it.value().name + '.' + dbcSignals[i].name)) << ties << it.key() << i;
+            }
+        }
+    }
+}
+
+void TestSignalCodec::fixedMatchesDouble()
+{
+    QFETCH(bool, ties);
+    QFETCH(uint32_t, canId);
+    QFETCH(int, signalIndex);
+
+    const DbcDatabase& db = ties ? m_ties : m_shipped;
+    const SignalCodec codec(db);
+    const DbcSignal sig = db.messages.value(canId).dbcSignals[signalIndex];
+    const double scale = std::pow(10.0, sig.fixedDecimals);
+    const uint64_t range = uint64_t{1} << sig.bitLength;
+    const uint64_t stride = std::max<uint64_t>(range / MaxRawSteps, 1);
+
+    for (uint64_t step = 0; step * stride < range; ++step) {
+        // The last step lands on the top of the range
+        const uint64_t raw = std::min(step * stride, range - 1);
+        CanFrame in;
+        SignalCodec::insertBits(in.data.data(), sig.startBit, sig.bitLength, sig.littleEndian, raw);
+
+        int64_t fixed = 0;
+        QVERIFY(codec.decodeSignalFixed(in, sig, fixed));
+        const double physical = codec.decodeSignal(in, sig).physicalValue;
+        if (std::llround(physical * scale) != fixed) {
+            QFAIL(qPrintable(QString("decode raw %1: fixed %2, double %3").arg(raw).arg(fixed).arg(physical, 0, 'g', 17)));
+        }
+
+        // The raw value itself, the half step above it and the next scaled unit past
+        // that, which rounds up. The double path is the reference; the only allowed
+        // difference is one raw step at an exact tie
+        const int64_t halfStep = fixed + sig.fixedFactor / 2;
+        const int64_t pastHalf = halfStep + (sig.fixedFactor < 0 ? -1 : 1);
+        for (const int64_t value : {fixed, halfStep, pastHalf}) {
+            CanFrame viaFixed;
+            CanFrame viaDouble;
+            QVERIFY(codec.encodeSignalFixed(viaFixed, sig, value));
+            QVERIFY(codec.encodeSignal(viaDouble, sig, static_cast<double>(value) / scale));
+            if (viaFixed.data == viaDouble.data) continue;
+
+            const bool tie = value == halfStep && sig.fixedFactor % 2 == 0;
+            int64_t fixedResult = 0;
+            int64_t doubleResult = 0;
+            QVERIFY(codec.decodeSignalFixed(viaFixed, sig, fixedResult));
+            QVERIFY(codec.decodeSignalFixed(viaDouble, sig, doubleResult));
+            if (!tie || std::abs(fixedResult - doubleResult) != std::abs(sig.fixedFactor)) {
+                QFAIL(qPrintable(QString("encode %1 (raw %2): fixed %3, double %4")
+                                     .arg(value).arg(raw).arg(fixedResult).arg(doubleResult)));
+            }
+        }
+    }
+}
+
+void TestSignalCodec::halfStepTie()
+{
+    // The documented exception: Fifth scales by 0.2, so 0.3 is exactly 1.5 raw steps.
+    // The fixed path rounds that away from zero; in double 0.3 / 0.2 is 1.4999...
+    const SignalCodec codec(m_ties);
+    const DbcSignal sig = m_ties.messages.value(256).dbcSignals[0];
+    QCOMPARE(sig.fixedDecimals, uint8_t{1});
+
+    CanFrame viaFixed;
+    CanFrame viaDouble;
+    QVERIFY(codec.encodeSignalFixed(viaFixed, sig, 3));
+    QVERIFY(codec.encodeSignal(viaDouble, sig, 0.3));
+    QCOMPARE(SignalCodec::extractBits(viaFixed.data.data(), sig.startBit, sig.bitLength, sig.littleEndian),
+             uint64_t{2});
+    QCOMPARE(SignalCodec::extractBits(viaDouble.data.data(), sig.startBit, sig.bitLength, sig.littleEndian),
+             uint64_t{1});
+}
+
+void TestSignalCodec::signedSaturation()
+{
+    // A range wider than the signal: out-of-range negative values saturate to the
+    // most negative raw value instead of wrapping to -1
+    DbcParser parser;
+    QVERIFY(parser.parseText(R"(VERSION ""
+
+BU_: CMS
+
+BO_ 256 Wide: 8 CMS
+ SG_ Wide : 0|8@1- (1,0) [-1000|1000] "" CMS
+)"));
+    const DbcDatabase& db = parser.database();
+    const SignalCodec codec(db);
+    const DbcSignal sig = db.messages.value(256).dbcSignals[0];
+    QVERIFY(!sig.rawRangeFits);
+
+    const struct { double value; double expected; } cases[] = {
+        {-1000.0, -128.0}, {-129.0, -128.0}, {-128.0, -128.0}, {-5.0, -5.0},
+        {127.0, 127.0}, {128.0, 127.0}, {1000.0, 127.0},
+    };
+    for (const auto& c : cases) {
+        CanFrame viaDouble;
+        CanFrame viaFixed;
+        QVERIFY(codec.encodeSignal(viaDouble, sig, c.value));
+        QVERIFY(codec.encodeSignalFixed(viaFixed, sig, static_cast<int64_t>(c.value)));
+        QCOMPARE(codec.decodeSignal(viaDouble, sig).physicalValue, c.expected);
+        QCOMPARE(codec.decodeSignal(viaFixed, sig).physicalValue, c.expected);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestSignalCodec)
+#include "tst_signal_codec.moc"
@@ -0,0 +1,91 @@
+#include "can/can_interface.h"
+#include "module/charge_module.h"
+#include <QtTest>
+#include <chrono>
+
+using namespace ccs;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint32_t EvStatusControlId = 0x1302; // 100 ms cycle in the shipped DBC
+constexpr auto Cycle = 100ms;
+constexpr auto Tolerance = 30ms;
+constexpr auto Stall = 2s;
+
+/// Always open; records when each EVStatusControl frame is written.
+/// write() is called on the TX scheduler thread.
+class RecordingCan : public CanInterface {
+public:
+    bool open(uint16_t, uint32_t) override { return true; }
+    void close() override {}
+    bool isOpen() const override { return true; }
+    std::vector<ChannelInfo> availableChannels() override { return {}; }
+    CanStatus status() const override { return CanStatus::Ok; }
+    QString lastError() const override { return {}; }
+
+    bool write(const CanFrame& frame) override
+    {
+        if (frame.id == EvStatusControlId) {
+            QMutexLocker lock(&m_mutex);
+            m_writes.push_back(std::chrono::steady_clock::now());
+        }
+        return true;
+    }
+
+    std::vector<std::chrono::steady_clock::time_point> writes() const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_writes;
+    }
+
+private:
+    mutable QMutex m_mutex;
+    std::vector<std::chrono::steady_clock::time_point> m_writes;
+};
+
+} // namespace
+
+class TestTxCadence : public QObject {
+    Q_OBJECT
+
+private slots:
+    void stalledCallerDoesNotDelayTx();
+};
+
+void TestTxCadence::stalledCallerDoesNotDelayTx()
+{
+    // The module on its own thread, as MainWindow runs it; this thread plays the GUI
+    RecordingCan can;
+    QThread moduleThread;
+    auto* module = new ChargeModule;
+    module->moveToThread(&moduleThread);
+    moduleThread.start();
+    module->setCanInterface(&can);
+    module->loadDbc(CCS_TEST_DBC);
+    module->start();
+
+    // A long GUI operation: no event processing at all for the whole stall
+    const auto stallEnd = std::chrono::steady_clock::now() + Stall;
+    while (std::chrono::steady_clock::now() < stallEnd) {
+    }
+    const auto writes = can.writes(); // before stop() adds its out-of-cycle safe state
+
+    module->stop();
+    QMetaObject::invokeMethod(module, [module] { delete module; }, Qt::BlockingQueuedConnection);
+    moduleThread.quit();
+    moduleThread.wait();
+
+    QVERIFY2(writes.size() >= static_cast<size_t>(Stall / Cycle) - 2,
+             qPrintable(QString("%1 EVStatusControl frames in %2 ms").arg(writes.size()).arg(Stall / 1ms)));
+    for (size_t i = 1; i < writes.size(); ++i) {
+        const auto interval = writes[i] - writes[i - 1];
+        if (interval < Cycle - Tolerance || interval > Cycle + Tolerance) {
+            QFAIL(qPrintable(QString("EVStatusControl interval %1: %2 ms")
+                                 .arg(i).arg(std::chrono::duration_cast<std::chrono::milliseconds>(interval).count())));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestTxCadence)
+#include "tst_tx_cadence.moc"